@@ -47,7 +47,8 @@
 
 #include "extern.h"
 
-#define _MAXBSIZE	(64 * 1024)
+#define _MAXBSIZE	(256 * 1024)
+#define HOLECHUNK	(64 * 1024)	/* granularity of hole detection */
 
 int copy_overwrite(void);
 
@@ -69,7 +70,7 @@ copy_file(FTSENT *entp, int exists)
 			err(1, "malloc");
 	}
 	if (!zeroes) {
-		zeroes = calloc(1, buflen);
+		zeroes = calloc(1, HOLECHUNK);
 		if (!zeroes)
 			err(1, "calloc");
 	}
@@ -140,14 +141,32 @@ copy_file(FTSENT *entp, int exists)
 	} else
 #endif
 	{
-		int skipholes = 0;
+		int n, skipholes = 0;
 		struct stat tosb;
 		if (!fstat(to_fd, &tosb) && S_ISREG(tosb.st_mode))
 			skipholes = 1;
 		while ((rcount = read(from_fd, buf, buflen)) > 0) {
-			if (skipholes && memcmp(buf, zeroes, rcount) == 0)
-				wcount = lseek(to_fd, rcount, SEEK_CUR) == -1 ? -1 : rcount;
-			else
+			if (skipholes) {
+				/*
+				 * Look for holes in HOLECHUNK pieces so a
+				 * bigger copy buffer does not coarsen the
+				 * sparseness of the result.
+				 */
+				for (wcount = 0; wcount < rcount;
+				    wcount += n) {
+					n = rcount - wcount;
+					if (n > HOLECHUNK)
+						n = HOLECHUNK;
+					if (memcmp(buf + wcount, zeroes,
+					    n) == 0) {
+						if (lseek(to_fd, n,
+						    SEEK_CUR) == -1)
+							break;
+					} else if (write(to_fd, buf + wcount,
+					    n) != n)
+						break;
+				}
+			} else
 				wcount = write(to_fd, buf, rcount);
 			if (rcount != wcount || wcount == -1) {
 				warn("%s", to.p_path);
@@ -485,14 +485,14 @@ int
 digest_file(const char *file, struct hash_list *hl, int echo)
 {
 	struct hash_function *hf;
-	FILE *fp;
-	size_t nread;
+	ssize_t nread;
+	int fd;
 	u_char data[32 * 1024];
 	char digest[MAX_DIGEST_LEN + 1];
 
 	if (strcmp(file, "-") == 0)
-		fp = stdin;
-	else if ((fp = fopen(file, "r")) == NULL) {
+		fd = STDIN_FILENO;
+	else if ((fd = open(file, O_RDONLY)) == -1) {
 		warn("cannot open %s", file);
 		return(1);
 	}
@@ -502,7 +502,7 @@ digest_file(const char *file, struct hash_list *hl, int echo)
 			err(1, NULL);
 		hf->init(hf->ctx);
 	}
-	while ((nread = fread(data, 1UL, sizeof(data), fp)) != 0) {
+	while ((nread = read(fd, data, sizeof(data))) > 0) {
 		if (echo) {
 			(void)fwrite(data, nread, 1UL, stdout);
 			(void)fflush(stdout);
@@ -512,23 +512,23 @@ digest_file(const char *file, struct hash_list *hl, int echo)
 		TAILQ_FOREACH(hf, hl, tailq)
 			hf->update(hf->ctx, data, nread);
 	}
-	if (ferror(fp)) {
+	if (nread == -1) {
 		warn("%s: read error", file);
-		if (fp != stdin)
-			fclose(fp);
+		if (fd != STDIN_FILENO)
+			close(fd);
 		TAILQ_FOREACH(hf, hl, tailq) {
 			free(hf->ctx);
 			hf->ctx = NULL;
 		}
 		return(1);
 	}
-	if (fp != stdin)
-		fclose(fp);
+	if (fd != STDIN_FILENO)
+		close(fd);
 	TAILQ_FOREACH(hf, hl, tailq) {
 		digest_end(hf, hf->ctx, digest, sizeof(digest), hf->base64);
 		free(hf->ctx);
 		hf->ctx = NULL;
-		if (fp == stdin)
+		if (fd == STDIN_FILENO)
 			fprintf(ofile, "%s\n", digest);
 		else
 			digest_print(hf, file, digest);
@@ -552,9 +552,10 @@ digest_filelist(const char *file, struct hash_function *defhash, int selcount,
 	const char *algorithm;
 	char *filename, *checksum, *line, *p, *tmpline;
 	char digest[MAX_DIGEST_LEN + 1];
-	ssize_t linelen;
-	FILE *listfp, *fp;
-	size_t len, linesize, nread;
+	ssize_t linelen, nread;
+	FILE *listfp;
+	int fd;
+	size_t len, linesize;
 	int *sel_found = NULL;
 	u_char data[32 * 1024];
 	union ANY_CTX context;
@@ -691,7 +692,7 @@ digest_filelist(const char *file, struct hash_function *defhash, int selcount,
 				continue;
 		}
 
-		if ((fp = fopen(filename, "r")) == NULL) {
+		if ((fd = open(filename, O_RDONLY)) == -1) {
 			warn("cannot open %s", filename);
 			(void)printf("(%s) %s: %s\n", algorithm, filename,
 			    (errno == ENOENT ? "MISSING" : "FAILED"));
@@ -700,15 +701,15 @@ digest_filelist(const char *file, struct hash_function *defhash, int selcount,
 		}
 
 		hf->init(&context);
-		while ((nread = fread(data, 1UL, sizeof(data), fp)) > 0)
+		while ((nread = read(fd, data, sizeof(data))) > 0)
 			hf->update(&context, data, nread);
-		if (ferror(fp)) {
+		if (nread == -1) {
 			warn("%s: read error", file);
 			error = 1;
-			fclose(fp);
+			close(fd);
 			continue;
 		}
-		fclose(fp);
+		close(fd);
 		digest_end(hf, &context, digest, sizeof(digest), base64);
 
 		if (base64)
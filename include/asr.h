@@ -62,6 +62,7 @@ void *asr_resolver_from_string(const char *);
 void asr_resolver_free(void *);
 int asr_run(struct asr_query *, struct asr_result *);
 int asr_run_sync(struct asr_query *, struct asr_result *);
+int asr_run_batch(struct asr_query **, struct asr_result *, size_t);
 void asr_abort(struct asr_query *);
 
 /*
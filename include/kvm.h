@@ -52,6 +52,7 @@ __BEGIN_DECLS
 
 typedef struct __kvm kvm_t;
 
+struct iovec;
 struct kinfo_proc;
 int	  kvm_close(kvm_t *);
 int	  kvm_dump_inval(kvm_t *);
@@ -71,6 +72,7 @@ kvm_t	 *kvm_openfiles(const char *, const char *, const char *,
 	        int, char *);
 ssize_t	  kvm_read(kvm_t *, unsigned long, void *, size_t)
 		__attribute__((__bounded__(__buffer__,3,4)));
+ssize_t	  kvm_readv(kvm_t *, unsigned long, const struct iovec *, int);
 ssize_t	  kvm_write(kvm_t *, unsigned long, const void *, size_t)
 		__attribute__((__bounded__(__buffer__,3,4)));
 
@@ -264,6 +264,146 @@ asr_run_sync(struct asr_query *as, struct asr_result *ar)
 }
 DEF_WEAK(asr_run_sync);
 
+/*
+ * State of one query in asr_run_batch().
+ */
+struct asr_batch {
+	struct timespec	 deadline;
+	int		 fd;
+	short		 events;
+	short		 state;
+#define ASR_BATCH_RUN	0	/* can be advanced right away */
+#define ASR_BATCH_WAIT	1	/* waiting for its fd or deadline */
+#define ASR_BATCH_DONE	2
+};
+
+/*
+ * Same as asr_run_sync(), but for an array of queries: all pending file
+ * descriptors are polled as a single set and a single earliest deadline
+ * is computed per wakeup, instead of sleeping on each query in turn.
+ * Results are stored in the corresponding slots of "ar".  Return 0 when
+ * all queries have completed (individual failures are reported in their
+ * result slot), or -1 if the bookkeeping arrays could not be allocated,
+ * in which case no query has been run or freed.
+ */
+int
+asr_run_batch(struct asr_query **as, struct asr_result *ar, size_t nas)
+{
+	struct asr_batch	*bq;
+	struct pollfd		*fds;
+	struct timespec		 now, tv;
+	size_t			*map;
+	size_t			 i, n, pending;
+	int			 r, timeout, saved_errno = errno;
+
+	bq = reallocarray(NULL, nas, sizeof(*bq));
+	fds = reallocarray(NULL, nas, sizeof(*fds));
+	map = reallocarray(NULL, nas, sizeof(*map));
+	if (bq == NULL || fds == NULL || map == NULL) {
+		free(bq);
+		free(fds);
+		free(map);
+		return (-1);
+	}
+
+	for (i = 0; i < nas; i++)
+		bq[i].state = ASR_BATCH_RUN;
+	pending = nas;
+
+	while (pending > 0) {
+		/* Advance all the queries that can be. */
+		for (i = 0; i < nas; i++) {
+			if (bq[i].state != ASR_BATCH_RUN)
+				continue;
+			if (asr_run(as[i], &ar[i]) == ASYNC_DONE) {
+				bq[i].state = ASR_BATCH_DONE;
+				pending--;
+				continue;
+			}
+			bq[i].fd = ar[i].ar_fd;
+			bq[i].events = (ar[i].ar_cond == ASR_WANT_READ) ?
+			    POLLIN : POLLOUT;
+			if (WRAP(clock_gettime)(CLOCK_MONOTONIC,
+			    &bq[i].deadline))
+				goto fail;
+			bq[i].deadline.tv_sec += ar[i].ar_timeout / 1000;
+			bq[i].deadline.tv_nsec +=
+			    (ar[i].ar_timeout % 1000) * 1000000;
+			if (bq[i].deadline.tv_nsec >= 1000000000) {
+				bq[i].deadline.tv_sec++;
+				bq[i].deadline.tv_nsec -= 1000000000;
+			}
+			bq[i].state = ASR_BATCH_WAIT;
+		}
+		if (pending == 0)
+			break;
+
+		/*
+		 * Poll all the pending descriptors as one set, waiting
+		 * no longer than the earliest deadline.
+		 */
+		if (WRAP(clock_gettime)(CLOCK_MONOTONIC, &now))
+			goto fail;
+		n = 0;
+		timeout = INFTIM;
+		for (i = 0; i < nas; i++) {
+			if (bq[i].state != ASR_BATCH_WAIT)
+				continue;
+			if (timespeccmp(&bq[i].deadline, &now, <=)) {
+				bq[i].state = ASR_BATCH_RUN;
+				timeout = 0;
+				continue;
+			}
+			fds[n].fd = bq[i].fd;
+			fds[n].events = bq[i].events;
+			fds[n].revents = 0;
+			map[n++] = i;
+			timespecsub(&bq[i].deadline, &now, &tv);
+			r = tv.tv_sec * 1000 + (tv.tv_nsec + 999999) / 1000000;
+			if (timeout == INFTIM || r < timeout)
+				timeout = r;
+		}
+		if (n == 0)
+			continue;
+		if ((r = poll(fds, n, timeout)) == -1) {
+			if (errno == EINTR)
+				continue;
+			goto fail;
+		}
+		for (i = 0; r > 0 && i < n; i++) {
+			if (fds[i].revents == 0)
+				continue;
+			bq[map[i]].state = ASR_BATCH_RUN;
+			r--;
+		}
+	}
+
+	free(bq);
+	free(fds);
+	free(map);
+	errno = saved_errno;
+	return (0);
+
+fail:
+	/* Fail the queries still in flight, as asr_run_sync() does. */
+	for (i = 0; i < nas; i++) {
+		if (bq[i].state == ASR_BATCH_DONE)
+			continue;
+		memset(&ar[i], 0, sizeof(ar[i]));
+		ar[i].ar_errno = errno;
+		ar[i].ar_h_errno = NETDB_INTERNAL;
+		ar[i].ar_gai_errno = EAI_SYSTEM;
+		ar[i].ar_rrset_errno = NETDB_INTERNAL;
+		_asr_async_free(as[i]);
+	}
+	free(bq);
+	free(fds);
+	free(map);
+	errno = saved_errno;
+	return (0);
+}
+DEF_WEAK(asr_run_batch);
+
 /*
  * Create a new async request of the given "type" on the async context "ac".
  * Take a reference on it so it does not get deleted while the async query
@@ -32,6 +32,7 @@
  * SUCH DAMAGE.
  */
 
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include <errno.h>
@@ -169,6 +170,22 @@ __hash_open(const char *file, int flags, int mode,
 
 		hashp->nmaps = bpages;
 		(void)memset(&hashp->mapp[0], 0, bpages * sizeof(u_int32_t *));
+
+		/*
+		 * A read-only table cannot change under us: map the file
+		 * once and let __get_page() copy pages out of the mapping
+		 * instead of issuing a pread() per page.  Fall back
+		 * silently to the read path if the file cannot be mapped.
+		 */
+		if ((hashp->flags & O_ACCMODE) == O_RDONLY &&
+		    fstat(hashp->fp, &statbuf) == 0 && statbuf.st_size > 0) {
+			hashp->mapaddr = mmap(NULL, (size_t)statbuf.st_size,
+			    PROT_READ, MAP_PRIVATE, hashp->fp, (off_t)0);
+			if (hashp->mapaddr == MAP_FAILED)
+				hashp->mapaddr = NULL;
+			else
+				hashp->mapsize = (size_t)statbuf.st_size;
+		}
 	}
 
 	/* Initialize Buffer Manager */
@@ -411,6 +428,8 @@ hdestroy(HTAB *hashp)
 	free(hashp->tmp_key);
 	free(hashp->tmp_buf);
 
+	if (hashp->mapaddr != NULL)
+		(void)munmap(hashp->mapaddr, hashp->mapsize);
 	if (hashp->fp != -1)
 		(void)close(hashp->fp);
 
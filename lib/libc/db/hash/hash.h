@@ -114,6 +114,8 @@ typedef struct htab	 {		/* Memory resident data structure */
 					 * allocate */
 	BUFHEAD 	bufhead;	/* Header of buffer lru list */
 	SEGMENT 	*dir;		/* Hash Bucket directory */
+	char		*mapaddr;	/* Read-only mapping of the file */
+	size_t		mapsize;	/* Size of the mapping */
 } HTAB;
 
 /*
@@ -512,6 +512,7 @@ __get_page(HTAB *hashp, char *p, u_int32_t bucket, int is_bucket, int is_disk,
 {
 	int fd, page, size, rsize;
 	u_int16_t *bp;
+	off_t off;
 
 	fd = hashp->fp;
 	size = hashp->BSIZE;
@@ -524,7 +525,23 @@ __get_page(HTAB *hashp, char *p, u_int32_t bucket, int is_bucket, int is_disk,
 		page = BUCKET_TO_PAGE(bucket);
 	else
 		page = OADDR_TO_PAGE(bucket);
-	if ((rsize = pread(fd, p, size, (off_t)page << hashp->BSHIFT)) == -1)
+	off = (off_t)page << hashp->BSHIFT;
+	if (hashp->mapaddr != NULL) {
+		/*
+		 * Read-only file mapped at open time: copy the page out
+		 * of the mapping.  The byte order fixups below are done
+		 * on the private copy.  A page at or past EOF is new,
+		 * just as with a zero-length pread().
+		 */
+		if (off >= (off_t)hashp->mapsize)
+			rsize = 0;
+		else {
+			rsize = size;
+			if ((off_t)hashp->mapsize - off < size)
+				rsize = hashp->mapsize - off;
+			memcpy(p, hashp->mapaddr + off, rsize);
+		}
+	} else if ((rsize = pread(fd, p, size, off)) == -1)
 		return (-1);
 	bp = (u_int16_t *)p;
 	if (!rsize)
@@ -24,6 +24,7 @@ PROTO_DEPRECATED(asr_abort);
 PROTO_NORMAL(asr_resolver_from_string);
 PROTO_NORMAL(asr_resolver_free);
 PROTO_NORMAL(asr_run);
+PROTO_NORMAL(asr_run_batch);
 PROTO_NORMAL(asr_run_sync);
 PROTO_NORMAL(getaddrinfo_async);
 PROTO_NORMAL(gethostbyaddr_async);
@@ -60,6 +60,7 @@
  */
 
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <assert.h>
 #include <errno.h>
@@ -74,16 +75,17 @@
 #define SAFE_ADD(x, y)			\
 do {					\
 	if ((x) > SIZE_MAX - (y))	\
-		return NULL;		\
+		goto map_err;		\
 	(x) += (y);			\
 } while (0);
 
-static int readrange(_RuneLocale *, _RuneRange *, uint32_t, void *, FILE *);
+static int readrange(_RuneLocale *, _RuneRange *, uint32_t, void *,
+	const uint8_t **, size_t *);
 static void _freeentry(_RuneRange *);
 
 static int
 readrange(_RuneLocale *rl, _RuneRange *rr, uint32_t nranges, void *lastp,
-	FILE *fp)
+	const uint8_t **fdata, size_t *fremain)
 {
 	uint32_t i;
 	_RuneEntry *re;
@@ -102,8 +104,11 @@ readrange(_RuneLocale *rl, _RuneRange *rr, uint32_t nranges, void *lastp,
 		if ((void *)re >= lastp)
 			return -1;
 
-		if (fread(&fre, sizeof(fre), 1, fp) != 1)
+		if (*fremain < sizeof(fre))
 			return -1;
+		memcpy(&fre, *fdata, sizeof(fre));
+		*fdata += sizeof(fre);
+		*fremain -= sizeof(fre);
 
 		re->re_min = ntohl((uint32_t)fre.fre_min);
 		re->re_max = ntohl((uint32_t)fre.fre_max);
@@ -115,7 +120,7 @@ readrange(_RuneLocale *rl, _RuneRange *rr, uint32_t nranges, void *lastp,
 }
 
 static int
-readentry(_RuneRange *rr, FILE *fp)
+readentry(_RuneRange *rr, const uint8_t **fdata, size_t *fremain)
 {
 	_RuneEntry *re;
 	size_t l, i, j;
@@ -140,8 +145,13 @@ readentry(_RuneRange *rr, FILE *fp)
 			goto fail;
 		}
 
-		if (fread(re[i].re_rune_types, sizeof(_RuneType), l, fp) != l)
+		if (*fremain / sizeof(_RuneType) < l) {
+			error = EINVAL;
 			goto fail2;
+		}
+		memcpy(re[i].re_rune_types, *fdata, l * sizeof(_RuneType));
+		*fdata += l * sizeof(_RuneType);
+		*fremain -= l * sizeof(_RuneType);
 
 		for (j = 0; j < l; j++)
 			re[i].re_rune_types[j] = ntohl(re[i].re_rune_types[j]);
@@ -159,7 +169,7 @@ fail2:
 		free(re[j].re_rune_types);
 		re[j].re_rune_types = NULL;
 	}
-	return errno;
+	return error;
 }
 
 /* XXX: temporary implementation */
@@ -210,6 +220,9 @@ _Read_RuneMagi(FILE *fp)
 {
 	/* file */
 	_FileRuneLocale frl;
+	void *fmap;
+	const uint8_t *fdata;
+	size_t fremain;
 	/* host data */
 	char *hostdata;
 	size_t hostdatalen;
@@ -226,13 +239,21 @@ _Read_RuneMagi(FILE *fp)
 		return NULL;
 	/* XXX more validation? */
 
-	/* Someone might have read the magic number once already */
-	rewind(fp);
-
-	if (fread(&frl, sizeof(frl), 1, fp) != 1)
+	/*
+	 * Map the file read-only and parse it from memory; the pages
+	 * are dropped again once the host-endian tables are built.
+	 */
+	fmap = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	if (fmap == MAP_FAILED)
 		return NULL;
+	fdata = fmap;
+	fremain = sb.st_size;
+
+	memcpy(&frl, fdata, sizeof(frl));
+	fdata += sizeof(frl);
+	fremain -= sizeof(frl);
 	if (memcmp(frl.frl_magic, _RUNE_MAGIC_1, sizeof(frl.frl_magic)))
-		return NULL;
+		goto map_err;
 
 	runetype_nranges = ntohl(frl.frl_runetype_ext.frr_nranges);
 	maplower_nranges = ntohl(frl.frl_maplower_ext.frr_nranges);
@@ -243,11 +264,11 @@ _Read_RuneMagi(FILE *fp)
 	if (runetype_nranges > SIZE_MAX / sizeof(_RuneEntry) ||
 	    maplower_nranges > SIZE_MAX / sizeof(_RuneEntry) ||
 	    mapupper_nranges > SIZE_MAX / sizeof(_RuneEntry))
-		return NULL;
+		goto map_err;
 #endif
 
 	if (var_len > INT32_MAX)
-		return NULL;
+		goto map_err;
 
 	hostdatalen = sizeof(*rl);
 	SAFE_ADD(hostdatalen, var_len);
@@ -256,7 +277,7 @@ _Read_RuneMagi(FILE *fp)
 	SAFE_ADD(hostdatalen, mapupper_nranges * sizeof(_RuneEntry));
 
 	if ((hostdata = calloc(hostdatalen, 1)) == NULL)
-		return NULL;
+		goto map_err;
 	lastp = hostdata + hostdatalen;
 
 	rl = (_RuneLocale *)hostdata;
@@ -272,12 +293,15 @@ _Read_RuneMagi(FILE *fp)
 		rl->rl_mapupper[x] = ntohl((uint32_t)frl.frl_mapupper[x]);
 	}
 
-	if (readrange(rl, &rl->rl_runetype_ext, runetype_nranges, lastp, fp) ||
-	    readrange(rl, &rl->rl_maplower_ext, maplower_nranges, lastp, fp) ||
-	    readrange(rl, &rl->rl_mapupper_ext, mapupper_nranges, lastp, fp))
+	if (readrange(rl, &rl->rl_runetype_ext, runetype_nranges, lastp,
+	    &fdata, &fremain) ||
+	    readrange(rl, &rl->rl_maplower_ext, maplower_nranges, lastp,
+	    &fdata, &fremain) ||
+	    readrange(rl, &rl->rl_mapupper_ext, mapupper_nranges, lastp,
+	    &fdata, &fremain))
 		goto err;
 
-	if (readentry(&rl->rl_runetype_ext, fp) != 0)
+	if (readentry(&rl->rl_runetype_ext, &fdata, &fremain) != 0)
 		goto err;
 
 	if ((uint8_t *)rl->rl_variable + rl->rl_variable_len >
@@ -286,21 +310,29 @@ _Read_RuneMagi(FILE *fp)
 
 	if (rl->rl_variable_len == 0)
 		rl->rl_variable = NULL;
-	else if (fread(rl->rl_variable, rl->rl_variable_len, 1, fp) != 1)
+	else if (fremain < rl->rl_variable_len)
 		goto rune_err;
+	else {
+		memcpy(rl->rl_variable, fdata, rl->rl_variable_len);
+		fdata += rl->rl_variable_len;
+		fremain -= rl->rl_variable_len;
+	}
 	if (find_codeset(rl))
 		goto rune_err;
 
 	/*
 	 * error if we have junk at the tail
 	 */
-	if (ftello(fp) != sb.st_size)
+	if (fremain != 0)
 		goto rune_err;
 
+	munmap(fmap, sb.st_size);
 	return(rl);
 rune_err:
 	_freeentry(&rl->rl_runetype_ext);
 err:
 	free(hostdata);
+map_err:
+	munmap(fmap, sb.st_size);
 	return NULL;
 }
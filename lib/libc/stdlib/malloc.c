@@ -128,10 +128,15 @@ LIST_HEAD(chunk_head, chunk_info);
 /* If the total # of pages is larger than this, evict before inserting */
 #define BIGCACHE_FILL(sz)	(MAX_BIGCACHEABLE_SIZE * (sz) / 4)
 
+/* How much a small cache may grow beyond its configured size */
+#define SMALLCACHE_GROW_FACTOR	4
+
 struct smallcache {
 	void **pages;
 	ushort length;
 	ushort max;
+	ushort hardmax;
+	ushort pressure;	/* evictions since the last grow */
 };
 
 struct bigcache {
@@ -507,9 +512,11 @@ omalloc_init(void)
 	size_t sb;
 
 	/*
-	 * Default options
+	 * Default options. Threads are spread over the non-special
+	 * pools, so more pools mean less sharing and lock contention
+	 * in processes with many threads.
 	 */
-	mopts.malloc_mutexes = 8;
+	mopts.malloc_mutexes = 16 > _MALLOC_MUTEXES ? _MALLOC_MUTEXES : 16;
 	mopts.def_malloc_junk = 1;
 	mopts.def_maxcache = MALLOC_DEFAULT_CACHE;
 
@@ -854,6 +861,9 @@ unmap(struct dir_info *d, void *p, size_t sz, size_t clear)
 	cache = &d->smallcache[psz - 1];
 	if (cache->length == cache->max) {
 		int fresh;
+		void *q;
+		u_short j;
+
 		/* use a random slot */
 		i = getrbyte(d) & (cache->max - 1);
 		r = cache->pages[i];
@@ -861,10 +871,53 @@ unmap(struct dir_info *d, void *p, size_t sz, size_t clear)
 		*(uintptr_t*)&r &= ~1UL;
 		if (!fresh && !mopts.malloc_freeunmap)
 			validate_junk(d, r, sz);
-		if (munmap(r, sz))
-			wrterror(d, "munmap %p", r);
-		STATS_SUB(d->malloc_used, sz);
-		cache->length--;
+		/*
+		 * If a neighbouring region sits in the cache, evict it
+		 * as well so both go in a single munmap call.
+		 */
+		for (j = 0; j < cache->length; j++) {
+			if (j == i)
+				continue;
+			q = (void *)((uintptr_t)cache->pages[j] & ~1UL);
+			if (q == (char *)r + sz || (char *)q + sz == r)
+				break;
+		}
+		if (j < cache->length) {
+			if (!((uintptr_t)cache->pages[j] & 1) &&
+			    !mopts.malloc_freeunmap) {
+				q = (void *)((uintptr_t)cache->pages[j] & ~1UL);
+				validate_junk(d, q, sz);
+			}
+			q = (void *)((uintptr_t)cache->pages[j] & ~1UL);
+			if (munmap(r < q ? r : q, 2 * sz))
+				wrterror(d, "munmap %p", r < q ? r : q);
+			STATS_SUB(d->malloc_used, 2 * sz);
+			/* remove the higher of the two slots first */
+			if (i < j) {
+				u_short t = i;
+
+				i = j;
+				j = t;
+			}
+			cache->pages[i] = cache->pages[--cache->length];
+			cache->pages[j] = cache->pages[--cache->length];
+		} else {
+			if (munmap(r, sz))
+				wrterror(d, "munmap %p", r);
+			STATS_SUB(d->malloc_used, sz);
+			cache->pages[i] = cache->pages[--cache->length];
+		}
+		i = cache->length;
+
+		/*
+		 * Churning through a full cache means the bursts are
+		 * larger than it can absorb; grow it, within bounds.
+		 */
+		if (++cache->pressure >= cache->max &&
+		    cache->max < cache->hardmax) {
+			cache->max <<= 1;
+			cache->pressure = 0;
+		}
 	} else
 		i = cache->length;
 
@@ -1486,7 +1539,10 @@ _malloc_init(int from_rthreads)
 			for (j = 0; j < MAX_SMALLCACHEABLE_SIZE; j++) {
 				d->smallcache[j].max =
 				    mopts.def_maxcache >> (j / 8);
-				sz += d->smallcache[j].max * sizeof(void *);
+				d->smallcache[j].hardmax =
+				    d->smallcache[j].max *
+				    SMALLCACHE_GROW_FACTOR;
+				sz += d->smallcache[j].hardmax * sizeof(void *);
 			}
 			sz += d->bigcache_size * sizeof(struct bigcache);
 			if (sz > 0) {
@@ -1499,7 +1555,7 @@ _malloc_init(int from_rthreads)
 					    "malloc_init mimmutable2 failed");
 				for (j = 0; j < MAX_SMALLCACHEABLE_SIZE; j++) {
 					d->smallcache[j].pages = p;
-					p = (char *)p + d->smallcache[j].max *
+					p = (char *)p + d->smallcache[j].hardmax *
 					    sizeof(void *);
 				}
 				d->bigcache = p;
@@ -31,18 +31,38 @@
  * SUCH DAMAGE.
  */
 
+#include <limits.h>
 #include <string.h>
 
+#define LONGBYTES	(sizeof(unsigned long))
+#define ONES		((unsigned long)-1 / UCHAR_MAX)
+#define HIGHS		(ONES * (UCHAR_MAX / 2 + 1))
+#define HASZERO(x)	(((x) - ONES) & ~(x) & HIGHS)
+
 void *
 memchr(const void *s, int c, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p = s;
+	const unsigned char *p = s;
+	const unsigned long *w;
+	unsigned long mask;
 
-		do {
-			if (*p++ == (unsigned char)c)
-				return ((void *)(p - 1));
-		} while (--n != 0);
+	/*
+	 * Scan bytes until the pointer is word aligned, then scan a
+	 * word at a time: xoring a word with the target byte repeated
+	 * in every position turns a match into a zero byte, which the
+	 * carry trick detects.
+	 */
+	for (; n != 0 && ((unsigned long)p & (LONGBYTES - 1)) != 0; p++, n--) {
+		if (*p == (unsigned char)c)
+			return ((void *)p);
+	}
+	mask = ONES * (unsigned char)c;
+	for (w = (const unsigned long *)p; n >= LONGBYTES &&
+	    HASZERO(*w ^ mask) == 0; w++, n -= LONGBYTES)
+		;
+	for (p = (const unsigned char *)w; n != 0; p++, n--) {
+		if (*p == (unsigned char)c)
+			return ((void *)p);
 	}
 	return (NULL);
 }
@@ -33,19 +33,48 @@
 
 #include <string.h>
 
+#define LONGBYTES	(sizeof(unsigned long))
+
 /*
  * Compare memory regions.
  */
 int
 memcmp(const void *s1, const void *s2, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p1 = s1, *p2 = s2;
+	const unsigned char *p1 = s1, *p2 = s2;
+
+	/*
+	 * If both regions can reach word alignment together, compare a
+	 * word at a time and let the byte loop find the differing byte
+	 * of an unequal word.
+	 */
+	if (n >= LONGBYTES &&
+	    ((unsigned long)p1 & (LONGBYTES - 1)) ==
+	    ((unsigned long)p2 & (LONGBYTES - 1))) {
+		const unsigned long *w1, *w2;
 
-		do {
-			if (*p1++ != *p2++)
-				return (*--p1 - *--p2);
-		} while (--n != 0);
+		while (((unsigned long)p1 & (LONGBYTES - 1)) != 0) {
+			if (*p1 != *p2)
+				return (*p1 - *p2);
+			p1++;
+			p2++;
+			n--;
+		}
+		w1 = (const unsigned long *)p1;
+		w2 = (const unsigned long *)p2;
+		while (n >= LONGBYTES && *w1 == *w2) {
+			w1++;
+			w2++;
+			n -= LONGBYTES;
+		}
+		p1 = (const unsigned char *)w1;
+		p2 = (const unsigned char *)w2;
+	}
+	while (n-- != 0) {
+		if (*p1 != *p2)
+			return (*p1 - *p2);
+		p1++;
+		p2++;
 	}
 	return (0);
 }
@@ -29,14 +29,33 @@
  * SUCH DAMAGE.
  */
 
+#include <limits.h>
 #include <string.h>
 
+#define LONGBYTES	(sizeof(unsigned long))
+#define ONES		((unsigned long)-1 / UCHAR_MAX)
+#define HIGHS		(ONES * (UCHAR_MAX / 2 + 1))
+#define HASZERO(x)	(((x) - ONES) & ~(x) & HIGHS)
+
 size_t
 strlen(const char *str)
 {
-	const char *s;
+	const char *s = str;
+	const unsigned long *w;
 
-	for (s = str; *s; ++s)
+	/*
+	 * Scan bytes up to word alignment, then look for the
+	 * terminator a word at a time. The aligned word reads never
+	 * cross a page boundary, so they cannot fault even when they
+	 * extend past the terminator.
+	 */
+	for (; ((unsigned long)s & (LONGBYTES - 1)) != 0; s++) {
+		if (*s == '\0')
+			return (s - str);
+	}
+	for (w = (const unsigned long *)s; HASZERO(*w) == 0; w++)
+		;
+	for (s = (const char *)w; *s != '\0'; s++)
 		;
 	return (s - str);
 }
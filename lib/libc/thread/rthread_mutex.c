@@ -37,6 +37,7 @@ enum {
 };
 
 #define SPIN_COUNT	128
+#define SPIN_BACKOFF_MAX 16
 #if defined(__i386__) || defined(__amd64__)
 #define SPIN_WAIT()	asm volatile("pause": : : "memory")
 #else
@@ -138,7 +139,7 @@ _rthread_mutex_timedlock(pthread_mutex_t *mutexp, int trywait,
 {
 	pthread_t self = pthread_self();
 	pthread_mutex_t mutex;
-	unsigned int i, lock;
+	unsigned int i, j, n, lock;
 	int error = 0;
 
 	if (mutexp == NULL)
@@ -168,12 +169,22 @@ _rthread_mutex_timedlock(pthread_mutex_t *mutexp, int trywait,
 	if (error != EBUSY || trywait)
 		return (error);
 
-	/* Try hard to not enter the kernel. */
-	for (i = 0; i < SPIN_COUNT; i++) {
-		if (mutex->lock == UNLOCKED)
+	/*
+	 * Try hard to not enter the kernel.  Pause in growing bursts
+	 * between probes so that a spinning cohort does not hammer the
+	 * cache line on every iteration; SPIN_COUNT is the total pause
+	 * budget.  Once the lock goes CONTENDED there are sleepers in
+	 * the kernel ahead of us and spinning only burns cycles, so
+	 * join them instead.
+	 */
+	for (i = 0, n = 1; i < SPIN_COUNT; i += n) {
+		if (mutex->lock != LOCKED)
 			break;
 
-		SPIN_WAIT();
+		for (j = 0; j < n; j++)
+			SPIN_WAIT();
+		if (n < SPIN_BACKOFF_MAX)
+			n <<= 1;
 	}
 
 	lock = atomic_cas_uint(&mutex->lock, UNLOCKED, LOCKED);
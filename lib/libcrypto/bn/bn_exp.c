@@ -385,6 +385,12 @@ MOD_EXP_CTIME_COPY_FROM_PREBUF(BIGNUM *b, int top, unsigned char *buf, int idx,
 #define MOD_EXP_CTIME_ALIGN(x_) \
 	((unsigned char*)(x_) + (MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH - (((size_t)(x_)) & (MOD_EXP_CTIME_MIN_CACHE_LINE_MASK))))
 
+/*
+ * Power buffers up to this size (enough for the CRT halves of RSA-2048)
+ * live on the stack, saving an allocation and wipe per exponentiation.
+ */
+#define MOD_EXP_CTIME_STACK_LEN	4608
+
 /* This variant of BN_mod_exp_mont() uses fixed windows and the special
  * precomputation memory layout to limit data-dependency to a minimum
  * to protect secret exponents (cf. the hyper-threading timing attacks
@@ -402,6 +408,7 @@ BN_mod_exp_mont_consttime(BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
 	unsigned char *powerbufFree = NULL;
 	int powerbufLen = 0;
 	unsigned char *powerbuf = NULL;
+	unsigned char stackbuf[MOD_EXP_CTIME_STACK_LEN];
 	BIGNUM tmp, am;
 
 
@@ -451,10 +458,16 @@ BN_mod_exp_mont_consttime(BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
 	numPowers = 1 << window;
 	powerbufLen = sizeof(m->d[0]) * (top * numPowers +
 	    ((2*top) > numPowers ? (2*top) : numPowers));
-	if ((powerbufFree = calloc(powerbufLen +
-	    MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH, 1)) == NULL)
-		goto err;
-	powerbuf = MOD_EXP_CTIME_ALIGN(powerbufFree);
+	if (powerbufLen + MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH <=
+	    sizeof(stackbuf)) {
+		memset(stackbuf, 0, sizeof(stackbuf));
+		powerbuf = MOD_EXP_CTIME_ALIGN(stackbuf);
+	} else {
+		if ((powerbufFree = calloc(powerbufLen +
+		    MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH, 1)) == NULL)
+			goto err;
+		powerbuf = MOD_EXP_CTIME_ALIGN(powerbufFree);
+	}
 
 	/* lay down tmp and am right after powers table */
 	tmp.d = (BN_ULONG *)(powerbuf + sizeof(m->d[0]) * top * numPowers);
@@ -641,7 +654,11 @@ BN_mod_exp_mont_consttime(BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
 err:
 	if ((in_mont == NULL) && (mont != NULL))
 		BN_MONT_CTX_free(mont);
-	freezero(powerbufFree, powerbufLen + MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH);
+	if (powerbufFree != NULL)
+		freezero(powerbufFree,
+		    powerbufLen + MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH);
+	else if (powerbuf != NULL)
+		explicit_bzero(stackbuf, sizeof(stackbuf));
 	BN_CTX_end(ctx);
 	return (ret);
 }
@@ -123,6 +123,8 @@ struct _Elf {
 				Elf64_Phdr *e_phdr64;
 			} e_phdr;
 			STAILQ_HEAD(, _Elf_Scn)	e_scn;	/* section list */
+			Elf_Scn	**e_scnindex;	/* section# -> descriptor */
+			size_t	e_scnindexsz;	/* capacity of e_scnindex */
 			size_t	e_nphdr;	/* number of Phdr entries */
 			size_t	e_nscn;		/* number of sections */
 			size_t	e_strndx;	/* string table section index */
@@ -149,6 +149,15 @@ elf_getscn(Elf *e, size_t index)
 	    _libelf_load_section_headers(e, ehdr) == 0)
 		return (NULL);
 
+	/*
+	 * Try the section index first; it is maintained on a
+	 * best-effort basis, so a section missing from it is
+	 * still searched for on the section list.
+	 */
+	if (index < e->e_u.e_elf.e_scnindexsz &&
+	    (s = e->e_u.e_elf.e_scnindex[index]) != NULL)
+		return (s);
+
 	STAILQ_FOREACH(s, &e->e_u.e_elf.e_scn, s_next)
 		if (s->s_ndx == index)
 			return (s);
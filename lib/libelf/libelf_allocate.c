@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <libelf.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -98,6 +99,8 @@ _libelf_release_elf(Elf *e)
 			break;
 		}
 
+		free(e->e_u.e_elf.e_scnindex);
+
 		assert(STAILQ_EMPTY(&e->e_u.e_elf.e_scn));
 
 		if (e->e_flags & LIBELF_F_AR_HEADER) {
@@ -146,7 +149,8 @@ _libelf_release_data(struct _Libelf_Data *d)
 Elf_Scn *
 _libelf_allocate_scn(Elf *e, size_t ndx)
 {
-	Elf_Scn *s;
+	Elf_Scn *s, **t;
+	size_t newsz, oldsz;
 
 	if ((s = calloc((size_t) 1, sizeof(Elf_Scn))) == NULL) {
 		LIBELF_SET_ERROR(RESOURCE, errno);
@@ -161,6 +165,27 @@ _libelf_allocate_scn(Elf *e, size_t ndx)
 
 	STAILQ_INSERT_TAIL(&e->e_u.e_elf.e_scn, s, s_next);
 
+	/*
+	 * Record the descriptor in the index used by elf_getscn().
+	 * The index is only a cache: if it cannot be grown, lookups
+	 * fall back to walking the section list.
+	 */
+	oldsz = e->e_u.e_elf.e_scnindexsz;
+	if (ndx >= oldsz) {
+		newsz = e->e_u.e_elf.e_nscn > ndx + 1 ?
+		    e->e_u.e_elf.e_nscn : ndx + 1;
+		if (newsz <= SIZE_MAX / sizeof(Elf_Scn *) &&
+		    (t = realloc(e->e_u.e_elf.e_scnindex,
+		    newsz * sizeof(Elf_Scn *))) != NULL) {
+			memset(t + oldsz, 0,
+			    (newsz - oldsz) * sizeof(Elf_Scn *));
+			e->e_u.e_elf.e_scnindex = t;
+			e->e_u.e_elf.e_scnindexsz = newsz;
+		}
+	}
+	if (ndx < e->e_u.e_elf.e_scnindexsz)
+		e->e_u.e_elf.e_scnindex[ndx] = s;
+
 	return (s);
 }
 
@@ -187,6 +212,10 @@ _libelf_release_scn(Elf_Scn *s)
 
 	assert(e != NULL);
 
+	if (s->s_ndx < e->e_u.e_elf.e_scnindexsz &&
+	    e->e_u.e_elf.e_scnindex[s->s_ndx] == s)
+		e->e_u.e_elf.e_scnindex[s->s_ndx] = NULL;
+
 	STAILQ_REMOVE(&e->e_u.e_elf.e_scn, s, _Elf_Scn, s_next);
 
 	free(s);
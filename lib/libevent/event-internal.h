@@ -33,9 +33,26 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 #include "min_heap.h"
 #include "evsignal.h"
 
+/*
+ * Hashed timer wheel, an O(1) alternative to the timeout min-heap for
+ * bases that arm and disarm very large numbers of timeouts.  Timeouts
+ * hash into a bucket by expiry tick; entries destined for a later
+ * rotation are skipped when the bucket is processed.
+ */
+#define TIMEOUT_WHEEL_BUCKETS	4096		/* power of two */
+#define TIMEOUT_WHEEL_TICK_USEC	10000		/* granularity: 10ms */
+
+struct timeout_wheel {
+	struct event_list buckets[TIMEOUT_WHEEL_BUCKETS];
+	uint64_t last_tick;	/* all earlier buckets processed */
+	int count;		/* pending timeouts on the wheel */
+};
+
 struct eventop {
 	const char *name;
 	void *(*init)(struct event_base *);
@@ -67,6 +84,7 @@ struct event_base {
 	struct timeval event_tv;
 
 	struct min_heap timeheap;
+	struct timeout_wheel *wheel;
 
 	struct timeval tv_cache;
 };
@@ -76,6 +76,7 @@ static void	event_process_active(struct event_base *);
 
 static int	timeout_next(struct event_base *, struct timeval **);
 static void	timeout_process(struct event_base *);
+static void	timeout_process_wheel(struct event_base *);
 
 static void
 gettime(struct event_base *base, struct timeval *tp)
@@ -93,6 +94,43 @@ gettime(struct event_base *base, struct timeval *tp)
 	TIMESPEC_TO_TIMEVAL(tp, &ts);
 }
 
+static uint64_t
+wheel_tick(const struct timeval *tv)
+{
+	return ((uint64_t)tv->tv_sec * (1000000 / TIMEOUT_WHEEL_TICK_USEC) +
+	    tv->tv_usec / TIMEOUT_WHEEL_TICK_USEC);
+}
+
+static struct event_list *
+wheel_bucket(struct timeout_wheel *wheel, const struct timeval *tv)
+{
+	return (&wheel->buckets[wheel_tick(tv) & (TIMEOUT_WHEEL_BUCKETS - 1)]);
+}
+
+int
+event_base_timer_wheel(struct event_base *base)
+{
+	struct timeout_wheel *wheel;
+	struct timeval now;
+	int i;
+
+	if (base->wheel != NULL)
+		return (0);
+	if (!min_heap_empty(&base->timeheap))
+		return (-1);
+
+	if ((wheel = calloc(1, sizeof(*wheel))) == NULL)
+		return (-1);
+	for (i = 0; i < TIMEOUT_WHEEL_BUCKETS; i++)
+		TAILQ_INIT(&wheel->buckets[i]);
+
+	gettime(base, &now);
+	wheel->last_tick = wheel_tick(&now);
+	base->wheel = wheel;
+
+	return (0);
+}
+
 struct event_base *
 event_init(void)
 {
@@ -169,6 +207,15 @@ event_base_free(struct event_base *base)
 		event_del(ev);
 		++n_deleted;
 	}
+	if (base->wheel != NULL) {
+		for (i = 0; i < TIMEOUT_WHEEL_BUCKETS; ++i) {
+			while ((ev =
+			    TAILQ_FIRST(&base->wheel->buckets[i])) != NULL) {
+				event_del(ev);
+				++n_deleted;
+			}
+		}
+	}
 
 	for (i = 0; i < base->nactivequeues; ++i) {
 		for (ev = TAILQ_FIRST(base->activequeues[i]); ev; ) {
@@ -193,6 +240,7 @@ event_base_free(struct event_base *base)
 
 	assert(min_heap_empty(&base->timeheap));
 	min_heap_dtor(&base->timeheap);
+	free(base->wheel);
 
 	for (i = 0; i < base->nactivequeues; ++i)
 		free(base->activequeues[i]);
@@ -676,7 +724,8 @@ event_add(struct event *ev, const struct timeval *tv)
 	 * prepare for timeout insertion further below, if we get a
 	 * failure on any step, we should not change any state.
 	 */
-	if (tv != NULL && !(ev->ev_flags & EVLIST_TIMEOUT)) {
+	if (tv != NULL && !(ev->ev_flags & EVLIST_TIMEOUT) &&
+	    base->wheel == NULL) {
 		if (min_heap_reserve(&base->timeheap,
 			1 + min_heap_size(&base->timeheap)) == -1)
 			return (-1);  /* ENOMEM == errno */
@@ -794,6 +843,20 @@ timeout_next(struct event_base *base, struct timeval **tv_p)
 	struct event *ev;
 	struct timeval *tv = *tv_p;
 
+	if (base->wheel != NULL) {
+		if (base->wheel->count == 0) {
+			*tv_p = NULL;
+			return (0);
+		}
+		/*
+		 * Wake up at the wheel granularity; timeout_process()
+		 * drains the buckets that have come due since.
+		 */
+		tv->tv_sec = 0;
+		tv->tv_usec = TIMEOUT_WHEEL_TICK_USEC;
+		return (0);
+	}
+
 	if ((ev = min_heap_top(&base->timeheap)) == NULL) {
 		/* if no time-based events are active wait for I/O */
 		*tv_p = NULL;
@@ -822,6 +885,11 @@ timeout_process(struct event_base *base)
 	struct timeval now;
 	struct event *ev;
 
+	if (base->wheel != NULL) {
+		timeout_process_wheel(base);
+		return;
+	}
+
 	if (min_heap_empty(&base->timeheap))
 		return;
 
@@ -840,6 +908,44 @@ timeout_process(struct event_base *base)
 	}
 }
 
+static void
+timeout_process_wheel(struct event_base *base)
+{
+	struct timeout_wheel *wheel = base->wheel;
+	struct event_list *bucket;
+	struct event *ev, *next;
+	struct timeval now;
+	uint64_t tick, i, n;
+
+	gettime(base, &now);
+	tick = wheel_tick(&now);
+
+	/* A full rotation visits every bucket; no point going further. */
+	n = tick - wheel->last_tick;
+	if (n > TIMEOUT_WHEEL_BUCKETS)
+		n = TIMEOUT_WHEEL_BUCKETS;
+
+	for (i = 0; i <= n; i++) {
+		bucket = &wheel->buckets[(wheel->last_tick + i) &
+		    (TIMEOUT_WHEEL_BUCKETS - 1)];
+		for (ev = TAILQ_FIRST(bucket); ev != NULL; ev = next) {
+			next = TAILQ_NEXT(ev, ev_timeout_next);
+
+			/* Not due yet: here for a later rotation. */
+			if (timercmp(&ev->ev_timeout, &now, >))
+				continue;
+
+			/* delete this event from the I/O queues */
+			event_del(ev);
+
+			event_debug(("%s: call %p",
+				 __func__, ev->ev_callback));
+			event_active(ev, EV_TIMEOUT, 1);
+		}
+	}
+	wheel->last_tick = tick;
+}
+
 void
 event_queue_remove(struct event_base *base, struct event *ev, int queue)
 {
@@ -861,7 +967,12 @@ event_queue_remove(struct event_base *base, struct event *ev, int queue)
 		    ev, ev_active_next);
 		break;
 	case EVLIST_TIMEOUT:
-		min_heap_erase(&base->timeheap, ev);
+		if (base->wheel != NULL) {
+			TAILQ_REMOVE(wheel_bucket(base->wheel, &ev->ev_timeout),
+			    ev, ev_timeout_next);
+			base->wheel->count--;
+		} else
+			min_heap_erase(&base->timeheap, ev);
 		break;
 	default:
 		event_errx(1, "%s: unknown queue %x", __func__, queue);
@@ -894,7 +1005,12 @@ event_queue_insert(struct event_base *base, struct event *ev, int queue)
 		    ev,ev_active_next);
 		break;
 	case EVLIST_TIMEOUT: {
-		min_heap_push(&base->timeheap, ev);
+		if (base->wheel != NULL) {
+			TAILQ_INSERT_TAIL(wheel_bucket(base->wheel,
+			    &ev->ev_timeout), ev, ev_timeout_next);
+			base->wheel->count++;
+		} else
+			min_heap_push(&base->timeheap, ev);
 		break;
 	}
 	default:
@@ -189,6 +189,7 @@ extern "C" {
 #define EV_WRITE	0x04
 #define EV_SIGNAL	0x08
 #define EV_PERSIST	0x10	/* Persistent event */
+#define EV_ET		0x20	/* Edge-triggered, if backend supports it */
 
 struct event_base;
 #ifndef EVENT_NO_STRUCT
@@ -196,6 +197,7 @@ struct event {
 	TAILQ_ENTRY (event) ev_next;
 	TAILQ_ENTRY (event) ev_active_next;
 	TAILQ_ENTRY (event) ev_signal_next;
+	TAILQ_ENTRY (event) ev_timeout_next;	/* for the timer wheel */
 	size_t min_heap_idx;	/* for managing timeouts */
 
 	struct event_base *ev_base;
@@ -270,6 +272,24 @@ struct event_base *event_init(void);
 */
 int event_reinit(struct event_base *base);
 
+/**
+  Manage this base's timeouts with a hashed timer wheel.
+
+  The wheel makes arming and disarming timeouts O(1) instead of the
+  O(lg n) of the default min-heap, at the cost of rounding timeout
+  expiry up to the wheel granularity (10 milliseconds).  It is a win
+  for bases that maintain very large numbers of frequently rescheduled
+  timeouts, such as per-connection idle timers.
+
+  Must be called before any timeouts are added to the base.
+
+  @param base the event base that should use a timer wheel
+  @return 0 if successful, or -1 if timeouts are already pending or
+    memory allocation failed.
+  @see event_base_new()
+*/
+int event_base_timer_wheel(struct event_base *base);
+
 /**
   Loop to process events.
 
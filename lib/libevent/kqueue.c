@@ -65,6 +65,7 @@ static void *kq_init	(struct event_base *);
 static int kq_add	(void *, struct event *);
 static int kq_del	(void *, struct event *);
 static int kq_dispatch	(struct event_base *, void *, struct timeval *);
+static int kq_grow	(struct kqop *);
 static int kq_insert	(struct kqop *, struct kevent *);
 static void kq_dealloc (struct event_base *, void *);
 
@@ -126,43 +127,49 @@ kq_init(struct event_base *base)
 }
 
 static int
-kq_insert(struct kqop *kqop, struct kevent *kev)
+kq_grow(struct kqop *kqop)
 {
+	struct kevent *newchange;
+	struct kevent *newresult;
 	int nevents = kqop->nevents;
 
-	if (kqop->nchanges == nevents) {
-		struct kevent *newchange;
-		struct kevent *newresult;
-
-		if (nevents > INT_MAX / 2) {
-			event_warnx("%s: integer overflow", __func__);
-			return (-1);
-		}
-		nevents *= 2;
+	if (nevents > INT_MAX / 2) {
+		event_warnx("%s: integer overflow", __func__);
+		return (-1);
+	}
+	nevents *= 2;
 
-		newchange = recallocarray(kqop->changes,
-		    kqop->nevents, nevents, sizeof(struct kevent));
-		if (newchange == NULL) {
-			event_warn("%s: recallocarray", __func__);
-			return (-1);
-		}
-		kqop->changes = newchange;
+	newchange = recallocarray(kqop->changes,
+	    kqop->nevents, nevents, sizeof(struct kevent));
+	if (newchange == NULL) {
+		event_warn("%s: recallocarray", __func__);
+		return (-1);
+	}
+	kqop->changes = newchange;
+
+	newresult = recallocarray(kqop->events,
+	    kqop->nevents, nevents, sizeof(struct kevent));
+
+	/*
+	 * If we fail, we don't have to worry about freeing,
+	 * the next realloc will pick it up.
+	 */
+	if (newresult == NULL) {
+		event_warn("%s: recallocarray", __func__);
+		return (-1);
+	}
+	kqop->events = newresult;
 
-		newresult = recallocarray(kqop->events,
-		    kqop->nevents, nevents, sizeof(struct kevent));
+	kqop->nevents = nevents;
 
-		/*
-		 * If we fail, we don't have to worry about freeing,
-		 * the next realloc will pick it up.
-		 */
-		if (newresult == NULL) {
-			event_warn("%s: recallocarray", __func__);
-			return (-1);
-		}
-		kqop->events = newresult;
+	return (0);
+}
 
-		kqop->nevents = nevents;
-	}
+static int
+kq_insert(struct kqop *kqop, struct kevent *kev)
+{
+	if (kqop->nchanges == kqop->nevents && kq_grow(kqop) == -1)
+		return (-1);
 
 	memcpy(&kqop->changes[kqop->nchanges++], kev, sizeof(struct kevent));
 
@@ -280,6 +287,14 @@ kq_dispatch(struct event_base *base, void *arg, struct timeval *tv)
 		}
 	}
 
+	/*
+	 * A full result buffer suggests that more events were pending.
+	 * Grow it so the next dispatch can drain them with one system
+	 * call; failure just means staying at the current size.
+	 */
+	if (res == kqop->nevents)
+		(void)kq_grow(kqop);
+
 	return (0);
 }
 
@@ -329,6 +344,8 @@ kq_add(void *arg, struct event *ev)
 		kev.flags = EV_ADD;
 		if (!(ev->ev_events & EV_PERSIST))
 			kev.flags |= EV_ONESHOT;
+		if (ev->ev_events & EV_ET)
+			kev.flags |= EV_CLEAR;
 		kev.udata = ev;
 
 		if (kq_insert(kqop, &kev) == -1)
@@ -344,6 +361,8 @@ kq_add(void *arg, struct event *ev)
 		kev.flags = EV_ADD;
 		if (!(ev->ev_events & EV_PERSIST))
 			kev.flags |= EV_ONESHOT;
+		if (ev->ev_events & EV_ET)
+			kev.flags |= EV_CLEAR;
 		kev.udata = ev;
 
 		if (kq_insert(kqop, &kev) == -1)
@@ -41,6 +41,7 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/sysctl.h>
+#include <sys/uio.h>
 
 #include <sys/core.h>
 #include <sys/exec.h>
@@ -901,6 +902,51 @@ kvm_read(kvm_t *kd, u_long kva, void *buf, size_t len)
 }
 DEF(kvm_read);
 
+ssize_t
+kvm_readv(kvm_t *kd, u_long kva, const struct iovec *iov, int iovcnt)
+{
+	size_t want, len;
+	ssize_t cc, total;
+	int i;
+
+	want = 0;
+	for (i = 0; i < iovcnt; i++) {
+		if (iov[i].iov_len > SSIZE_MAX - want) {
+			_kvm_err(kd, kd->program, "iovec too large");
+			return (-1);
+		}
+		want += iov[i].iov_len;
+	}
+
+	if (ISALIVE(kd)) {
+		/*
+		 * As in kvm_read, but gather the contiguous kernel
+		 * memory into all the buffers with a single system call.
+		 */
+		cc = preadv(kd->vmfd, iov, iovcnt, (off_t)kva);
+		if (cc == -1) {
+			_kvm_err(kd, 0, "invalid address (%lx)", kva);
+			return (-1);
+		} else if (cc < want)
+			_kvm_err(kd, kd->program, "short read");
+		return (cc);
+	}
+
+	/* Dead kernels translate page by page anyway; reuse kvm_read. */
+	total = 0;
+	for (i = 0; i < iovcnt; i++) {
+		len = iov[i].iov_len;
+		cc = kvm_read(kd, kva, iov[i].iov_base, len);
+		if (cc == -1)
+			return (-1);
+		total += cc;
+		if (cc < len)
+			break;
+		kva += cc;
+	}
+	return (total);
+}
+
 ssize_t
 kvm_write(kvm_t *kd, u_long kva, const void *buf, size_t len)
 {
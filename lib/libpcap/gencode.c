@@ -275,6 +275,85 @@ static bpf_u_int32 netmask;
 static int snaplen;
 int no_optimize;
 
+/*
+ * Cache of recently compiled filter programs.  Monitoring tools compile
+ * the same expression again every time they re-open a capture, and
+ * optimizing a large filter can take hundreds of milliseconds, so
+ * remember the last few results.  Compilation is deterministic in the
+ * expression, link type, snapshot length, netmask and optimize flag,
+ * which together form the key.  The caller gets its own copy of the
+ * program and frees it with pcap_freecode() as usual.
+ */
+#define FCODE_CACHE_SIZE 8
+
+static struct fcode_cache_entry {
+	char *expr;
+	int linktype;
+	int snaplen;
+	bpf_u_int32 netmask;
+	int optimize;
+	struct bpf_program fcode;
+} fcode_cache[FCODE_CACHE_SIZE];
+static int fcode_cache_next;
+
+static int
+fcode_cache_lookup(const char *expr, int linktype, int snap,
+    bpf_u_int32 mask, int optimize, struct bpf_program *program)
+{
+	struct fcode_cache_entry *e;
+	struct bpf_insn *insns;
+	int i;
+
+	for (i = 0; i < FCODE_CACHE_SIZE; i++) {
+		e = &fcode_cache[i];
+		if (e->expr == NULL || e->linktype != linktype ||
+		    e->snaplen != snap || e->netmask != mask ||
+		    e->optimize != optimize || strcmp(e->expr, expr) != 0)
+			continue;
+		insns = reallocarray(NULL, e->fcode.bf_len,
+		    sizeof(*insns));
+		if (insns == NULL)
+			return (0);
+		memcpy(insns, e->fcode.bf_insns,
+		    e->fcode.bf_len * sizeof(*insns));
+		program->bf_insns = insns;
+		program->bf_len = e->fcode.bf_len;
+		return (1);
+	}
+	return (0);
+}
+
+static void
+fcode_cache_store(const char *expr, int linktype, int snap,
+    bpf_u_int32 mask, int optimize, const struct bpf_program *program)
+{
+	struct fcode_cache_entry *e;
+	struct bpf_insn *insns;
+	char *copy;
+
+	if ((copy = strdup(expr)) == NULL)
+		return;
+	insns = reallocarray(NULL, program->bf_len, sizeof(*insns));
+	if (insns == NULL) {
+		free(copy);
+		return;
+	}
+	memcpy(insns, program->bf_insns,
+	    program->bf_len * sizeof(*insns));
+
+	e = &fcode_cache[fcode_cache_next];
+	fcode_cache_next = (fcode_cache_next + 1) % FCODE_CACHE_SIZE;
+	free(e->expr);
+	free(e->fcode.bf_insns);
+	e->expr = copy;
+	e->linktype = linktype;
+	e->snaplen = snap;
+	e->netmask = mask;
+	e->optimize = optimize;
+	e->fcode.bf_insns = insns;
+	e->fcode.bf_len = program->bf_len;
+}
+
 int
 pcap_compile(pcap_t *p, struct bpf_program *program,
 	     const char *buf, int optimize, bpf_u_int32 mask)
@@ -294,6 +373,10 @@ pcap_compile(pcap_t *p, struct bpf_program *program,
 	netmask = mask;
 	snaplen = pcap_snapshot(p);
 
+	if (buf != NULL && fcode_cache_lookup(buf, pcap_datalink(p),
+	    snaplen, mask, optimize, program))
+		return (0);
+
 	lex_init(buf ? buf : "");
 	init_linktype(pcap_datalink(p));
 	(void)pcap_parse();
@@ -313,6 +396,10 @@ pcap_compile(pcap_t *p, struct bpf_program *program,
 	program->bf_insns = icode_to_fcode(root, &len);
 	program->bf_len = len;
 
+	if (buf != NULL)
+		fcode_cache_store(buf, pcap_datalink(p), snaplen, mask,
+		    optimize, program);
+
 	freechunks();
 	return (0);
 }
@@ -18,6 +18,7 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 
 #include <netinet/in.h>
@@ -158,6 +159,7 @@ size_t
 _aucat_wdata(struct aucat *hdl, const void *buf, size_t len,
    unsigned int wbpf, int *eof)
 {
+	struct iovec iov[2];
 	ssize_t n;
 	size_t datasize;
 
@@ -173,7 +175,40 @@ _aucat_wdata(struct aucat *hdl, const void *buf, size_t len,
 		hdl->wmsg.u.data.size = htonl(datasize);
 		hdl->wtodo = sizeof(struct amsg);
 		hdl->wstate = WSTATE_MSG;
-		/* FALLTHROUGH */
+
+		/*
+		 * The header was just built, so send it together with
+		 * the beginning of the data block in a single
+		 * writev(2) call, saving one syscall per block.
+		 */
+		if (len > datasize)
+			len = datasize;
+		iov[0].iov_base = &hdl->wmsg;
+		iov[0].iov_len = sizeof(struct amsg);
+		iov[1].iov_base = (void *)buf;
+		iov[1].iov_len = len;
+		while ((n = writev(hdl->fd, iov, 2)) == -1) {
+			if (errno == EINTR)
+				continue;
+			if (errno != EAGAIN) {
+				*eof = 1;
+				DPERROR("_aucat_wdata: writev");
+			}
+			return 0;
+		}
+		if ((size_t)n < sizeof(struct amsg)) {
+			hdl->wtodo -= n;
+			return 0;
+		}
+		n -= sizeof(struct amsg);
+		DPRINTFN(2, "_aucat_wdata: writev: n = %zd\n", n);
+		hdl->wtodo = datasize - n;
+		if (hdl->wtodo == 0) {
+			hdl->wstate = WSTATE_IDLE;
+			hdl->wtodo = 0xdeadbeef;
+		} else
+			hdl->wstate = WSTATE_DATA;
+		return n;
 	case WSTATE_MSG:
 		if (!_aucat_wmsg(hdl, eof))
 			return 0;
@@ -145,6 +145,7 @@
 #include <netinet/in.h>
 
 #include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 
 #include <openssl/dh.h>
@@ -430,9 +431,9 @@ SSL_has_matching_session_id(const SSL *ssl, const unsigned char *id,
 	r.session_id_length = id_len;
 	memcpy(r.session_id, id, id_len);
 
-	CRYPTO_r_lock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_lock(&ssl->ctx->sessions_lock);
 	p = lh_SSL_SESSION_retrieve(ssl->ctx->sessions, &r);
-	CRYPTO_r_unlock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_unlock(&ssl->ctx->sessions_lock);
 	return (p != NULL);
 }
 LSSL_ALIAS(SSL_has_matching_session_id);
@@ -2112,6 +2113,7 @@ SSL_CTX_new(const SSL_METHOD *meth)
 	ret->sessions = lh_SSL_SESSION_new();
 	if (ret->sessions == NULL)
 		goto err;
+	pthread_mutex_init(&ret->sessions_lock, NULL);
 	ret->cert_store = X509_STORE_new();
 	if (ret->cert_store == NULL)
 		goto err;
@@ -2192,6 +2194,7 @@ SSL_CTX_free(SSL_CTX *ctx)
 	CRYPTO_free_ex_data(CRYPTO_EX_INDEX_SSL_CTX, ctx, &ctx->ex_data);
 
 	lh_SSL_SESSION_free(ctx->sessions);
+	pthread_mutex_destroy(&ctx->sessions_lock);
 
 	X509_STORE_free(ctx->cert_store);
 	sk_SSL_CIPHER_free(ctx->cipher_list);
@@ -146,6 +146,7 @@
 #include <sys/types.h>
 
 #include <errno.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -794,6 +795,12 @@ struct ssl_ctx_st {
 
 	struct lhash_st_SSL_SESSION *sessions;
 
+	/*
+	 * Protects sessions, the cache LRU list and its counters, so
+	 * that contexts do not contend on the one global CRYPTO lock.
+	 */
+	pthread_mutex_t sessions_lock;
+
 	/* Most session-ids that will be cached, default is
 	 * SSL_SESSION_CACHE_MAX_SIZE_DEFAULT. 0 is unlimited. */
 	unsigned long session_cache_size;
@@ -135,6 +135,8 @@
  * OTHERWISE.
  */
 
+#include <pthread.h>
+
 #include <openssl/lhash.h>
 #include <openssl/opensslconf.h>
 
@@ -556,11 +558,11 @@ ssl_session_from_cache(SSL *s, CBS *session_id)
 	    sizeof(data.session_id), &data.session_id_length))
 		return NULL;
 
-	CRYPTO_r_lock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_lock(&s->session_ctx->sessions_lock);
 	sess = lh_SSL_SESSION_retrieve(s->session_ctx->sessions, &data);
 	if (sess != NULL)
 		CRYPTO_add(&sess->references, 1, CRYPTO_LOCK_SSL_SESSION);
-	CRYPTO_r_unlock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_unlock(&s->session_ctx->sessions_lock);
 
 	if (sess == NULL)
 		s->session_ctx->stats.sess_miss++;
@@ -768,7 +770,7 @@ SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 	 * If session c is in already in cache, we take back the increment
 	 * later.
 	 */
-	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_lock(&ctx->sessions_lock);
 	s = lh_SSL_SESSION_insert(ctx->sessions, c);
 
 	/*
@@ -821,7 +823,7 @@ SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 			}
 		}
 	}
-	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_unlock(&ctx->sessions_lock);
 	return (ret);
 }
 LSSL_ALIAS(SSL_CTX_add_session);
@@ -843,14 +845,14 @@ remove_session_lock(SSL_CTX *ctx, SSL_SESSION *c, int lck)
 		return 0;
 
 	if (lck)
-		CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+		pthread_mutex_lock(&ctx->sessions_lock);
 	if ((r = lh_SSL_SESSION_retrieve(ctx->sessions, c)) == c) {
 		ret = 1;
 		r = lh_SSL_SESSION_delete(ctx->sessions, c);
 		SSL_SESSION_list_remove(ctx, c);
 	}
 	if (lck)
-		CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+		pthread_mutex_unlock(&ctx->sessions_lock);
 
 	if (ret) {
 		r->not_resumable = 1;
@@ -1167,10 +1169,10 @@ SSL_CTX_flush_sessions(SSL_CTX *s, long t)
 		return;
 	tp.time = t;
 
-	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_lock(&s->sessions_lock);
 	lh_SSL_SESSION_doall_arg(tp.cache, timeout_LHASH_DOALL_ARG,
 	    TIMEOUT_PARAM, &tp);
-	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+	pthread_mutex_unlock(&s->sessions_lock);
 }
 LSSL_ALIAS(SSL_CTX_flush_sessions);
 
@@ -685,10 +685,10 @@ static int
 tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
     uint8_t content_type, const uint8_t *content, size_t content_len)
 {
-	uint8_t *data = NULL, *header = NULL, *inner = NULL;
-	size_t data_len = 0, header_len = 0, inner_len = 0;
+	uint8_t *data = NULL;
+	size_t data_len = 0;
 	uint8_t *enc_record;
-	size_t enc_record_len;
+	size_t enc_record_len, inner_len;
 	ssize_t ret = 0;
 	size_t out_len;
 	CBB cbb;
@@ -698,17 +698,8 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 
 	memset(&cbb, 0, sizeof(cbb));
 
-	/* Build inner plaintext. */
-	if (!CBB_init(&cbb, content_len + 1))
-		goto err;
-	if (!CBB_add_bytes(&cbb, content, content_len))
-		goto err;
-	if (!CBB_add_u8(&cbb, content_type))
-		goto err;
 	/* XXX - padding? */
-	if (!CBB_finish(&cbb, &inner, &inner_len))
-		goto err;
-
+	inner_len = content_len + 1;
 	if (inner_len > TLS13_RECORD_MAX_INNER_PLAINTEXT_LEN)
 		goto err;
 
@@ -717,8 +708,8 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 	if (enc_record_len > TLS13_RECORD_MAX_CIPHERTEXT_LEN)
 		goto err;
 
-	/* Build the record header. */
-	if (!CBB_init(&cbb, TLS13_RECORD_HEADER_LEN))
+	/* Build the record, encrypting the inner plaintext in place. */
+	if (!CBB_init(&cbb, TLS13_RECORD_HEADER_LEN + enc_record_len))
 		goto err;
 	if (!CBB_add_u8(&cbb, SSL3_RT_APPLICATION_DATA))
 		goto err;
@@ -726,32 +717,23 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 		goto err;
 	if (!CBB_add_u16(&cbb, enc_record_len))
 		goto err;
-	if (!CBB_finish(&cbb, &header, &header_len))
-		goto err;
-
-	/* Build the actual record. */
-	if (!CBB_init(&cbb, TLS13_RECORD_HEADER_LEN + enc_record_len))
-		goto err;
-	if (!CBB_add_bytes(&cbb, header, header_len))
-		goto err;
 	if (!CBB_add_space(&cbb, &enc_record, enc_record_len))
 		goto err;
 	if (!CBB_finish(&cbb, &data, &data_len))
 		goto err;
 
+	/* Inner plaintext - the header doubles as additional data. */
+	memcpy(enc_record, content, content_len);
+	enc_record[content_len] = content_type;
+
 	if (!tls13_record_layer_update_nonce(&rl->write->nonce,
 	    &rl->write->iv, rl->write->seq_num))
 		goto err;
 
-	/*
-	 * XXX - consider a EVP_AEAD_CTX_seal_iov() that takes an iovec...
-	 * this would avoid a copy since the inner would be passed as two
-	 * separate pieces.
-	 */
 	if (!EVP_AEAD_CTX_seal(rl->write->aead_ctx,
 	    enc_record, &out_len, enc_record_len,
 	    rl->write->nonce.data, rl->write->nonce.len,
-	    inner, inner_len, header, header_len))
+	    enc_record, inner_len, data, TLS13_RECORD_HEADER_LEN))
 		goto err;
 
 	if (out_len != enc_record_len)
@@ -775,8 +757,6 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 	CBB_cleanup(&cbb);
 
 	freezero(data, data_len);
-	freezero(header, header_len);
-	freezero(inner, inner_len);
 
 	return ret;
 }
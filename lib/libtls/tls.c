@@ -22,6 +22,7 @@
 #include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <openssl/bio.h>
@@ -562,23 +563,131 @@ tls_configure_ssl(struct tls *ctx, SSL_CTX *ssl_ctx)
 	return (-1);
 }
 
+static int
+tls_verify_cache_hash(X509_STORE_CTX *x509_ctx, unsigned char *hash)
+{
+	STACK_OF(X509) *chain;
+	EVP_MD_CTX *md_ctx = NULL;
+	unsigned char d[EVP_MAX_MD_SIZE];
+	unsigned int dlen;
+	X509 *cert;
+	int i, rv = -1;
+
+	if ((cert = X509_STORE_CTX_get0_cert(x509_ctx)) == NULL)
+		goto err;
+
+	if ((md_ctx = EVP_MD_CTX_new()) == NULL)
+		goto err;
+	if (!EVP_DigestInit_ex(md_ctx, EVP_sha256(), NULL))
+		goto err;
+
+	if (X509_digest(cert, EVP_sha256(), d, &dlen) != 1)
+		goto err;
+	if (!EVP_DigestUpdate(md_ctx, d, dlen))
+		goto err;
+
+	if ((chain = X509_STORE_CTX_get0_untrusted(x509_ctx)) != NULL) {
+		for (i = 0; i < sk_X509_num(chain); i++) {
+			if (X509_digest(sk_X509_value(chain, i),
+			    EVP_sha256(), d, &dlen) != 1)
+				goto err;
+			if (!EVP_DigestUpdate(md_ctx, d, dlen))
+				goto err;
+		}
+	}
+
+	if (!EVP_DigestFinal_ex(md_ctx, hash, NULL))
+		goto err;
+
+	rv = 0;
+
+ err:
+	EVP_MD_CTX_free(md_ctx);
+
+	return (rv);
+}
+
+static int
+tls_verify_cache_lookup(struct tls_config *config, const unsigned char *hash)
+{
+	struct tls_verify_cache_entry *entry;
+	time_t now = time(NULL);
+	int i, found = 0;
+
+	pthread_mutex_lock(&config->mutex);
+	for (i = 0; i < TLS_VERIFY_CACHE_SIZE; i++) {
+		entry = &config->verify_cache[i];
+		if (entry->expiry >= now && memcmp(entry->chain_hash, hash,
+		    sizeof(entry->chain_hash)) == 0) {
+			found = 1;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&config->mutex);
+
+	return (found);
+}
+
+static void
+tls_verify_cache_store(struct tls_config *config, const unsigned char *hash)
+{
+	struct tls_verify_cache_entry *entry, *victim;
+	time_t now = time(NULL);
+	int i;
+
+	pthread_mutex_lock(&config->mutex);
+
+	/* Prefer an expired slot, otherwise evict the next to expire. */
+	victim = &config->verify_cache[0];
+	for (i = 0; i < TLS_VERIFY_CACHE_SIZE; i++) {
+		entry = &config->verify_cache[i];
+		if (entry->expiry < now) {
+			victim = entry;
+			break;
+		}
+		if (entry->expiry < victim->expiry)
+			victim = entry;
+	}
+	memcpy(victim->chain_hash, hash, sizeof(victim->chain_hash));
+	victim->expiry = now + config->verify_cache_lifetime;
+
+	pthread_mutex_unlock(&config->mutex);
+}
+
 static int
 tls_ssl_cert_verify_cb(X509_STORE_CTX *x509_ctx, void *arg)
 {
 	struct tls *ctx = arg;
+	unsigned char chain_hash[TLS_VERIFY_CACHE_HASH_SIZE];
+	int cache_chain = 0;
 	int x509_err;
 
 	if (ctx->config->verify_cert == 0)
 		return (1);
 
+	/*
+	 * If the exact same chain was successfully verified against this
+	 * configuration recently, skip re-verification.  Only successful
+	 * verifications are cached and only for the configured lifetime.
+	 */
+	if (ctx->config->verify_cache_lifetime > 0 &&
+	    tls_verify_cache_hash(x509_ctx, chain_hash) == 0) {
+		if (tls_verify_cache_lookup(ctx->config, chain_hash))
+			return (1);
+		cache_chain = 1;
+	}
+
 	if ((X509_verify_cert(x509_ctx)) < 0) {
 		tls_set_errorx(ctx, "X509 verify cert failed");
 		return (0);
 	}
 
 	x509_err = X509_STORE_CTX_get_error(x509_ctx);
-	if (x509_err == X509_V_OK)
+	if (x509_err == X509_V_OK) {
+		if (cache_chain)
+			tls_verify_cache_store(ctx->config, chain_hash);
 		return (1);
+	}
 
 	tls_set_errorx(ctx, "certificate verification failed: %s",
 	    X509_verify_cert_error_string(x509_err));
@@ -158,6 +158,8 @@ int tls_config_parse_protocols(uint32_t *_protocols, const char *_protostr);
 int tls_config_set_session_id(struct tls_config *_config,
     const unsigned char *_session_id, size_t _len);
 int tls_config_set_session_lifetime(struct tls_config *_config, int _lifetime);
+int tls_config_set_verify_cache_lifetime(struct tls_config *_config,
+    int _lifetime);
 int tls_config_add_ticket_key(struct tls_config *_config, uint32_t _keyrev,
     unsigned char *_key, size_t _keylen);
 
@@ -179,6 +179,7 @@ tls_config_free(struct tls_config *config)
 	free((char *)config->ciphers);
 	free((char *)config->crl_mem);
 	free(config->ecdhecurves);
+	free(config->verify_cache);
 
 	pthread_mutex_destroy(&config->mutex);
 
@@ -870,6 +871,25 @@ tls_config_set_session_lifetime(struct tls_config *config, int lifetime)
 	return (0);
 }
 
+int
+tls_config_set_verify_cache_lifetime(struct tls_config *config, int lifetime)
+{
+	if (lifetime < 0) {
+		tls_config_set_errorx(config, "invalid verify cache lifetime");
+		return (-1);
+	}
+	if (lifetime > 0 && config->verify_cache == NULL) {
+		if ((config->verify_cache = calloc(TLS_VERIFY_CACHE_SIZE,
+		    sizeof(*config->verify_cache))) == NULL) {
+			tls_config_set_errorx(config, "out of memory");
+			return (-1);
+		}
+	}
+
+	config->verify_cache_lifetime = lifetime;
+	return (0);
+}
+
 int
 tls_config_add_ticket_key(struct tls_config *config, uint32_t keyrev,
     unsigned char *key, size_t keylen)
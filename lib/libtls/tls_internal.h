@@ -78,6 +78,14 @@ struct tls_ticket_key {
 	time_t		time;
 };
 
+#define TLS_VERIFY_CACHE_SIZE			64
+#define TLS_VERIFY_CACHE_HASH_SIZE		32	/* SHA-256 */
+
+struct tls_verify_cache_entry {
+	unsigned char	chain_hash[TLS_VERIFY_CACHE_HASH_SIZE];
+	time_t		expiry;
+};
+
 typedef int (*tls_sign_cb)(void *_cb_arg, const char *_pubkey_hash,
     const uint8_t *_input, size_t _input_len, int _padding_type,
     uint8_t **_out_signature, size_t *_out_signature_len);
@@ -109,6 +117,8 @@ struct tls_config {
 	struct tls_ticket_key ticket_keys[TLS_NUM_TICKETS];
 	uint32_t ticket_keyrev;
 	int ticket_autorekey;
+	struct tls_verify_cache_entry *verify_cache;
+	int verify_cache_lifetime;
 	int verify_cert;
 	int verify_client;
 	int verify_depth;
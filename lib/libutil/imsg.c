@@ -43,6 +43,7 @@ imsg_init(struct imsgbuf *imsgbuf, int fd)
 {
 	msgbuf_init(&imsgbuf->w);
 	memset(&imsgbuf->r, 0, sizeof(imsgbuf->r));
+	imsgbuf->r.rptr = imsgbuf->r.buf;
 	imsgbuf->fd = fd;
 	imsgbuf->w.fd = fd;
 	imsgbuf->pid = getpid();
@@ -66,6 +67,17 @@ imsg_read(struct imsgbuf *imsgbuf)
 	memset(&msg, 0, sizeof(msg));
 	memset(&cmsgbuf, 0, sizeof(cmsgbuf));
 
+	/*
+	 * Consumed bytes can sit in front of the unread data if the
+	 * caller did not drain the buffer with imsg_get() first; make
+	 * room for a full read in that case.
+	 */
+	if (imsgbuf->r.rptr > imsgbuf->r.buf) {
+		imsgbuf->r.wpos -= imsgbuf->r.rptr - imsgbuf->r.buf;
+		memmove(imsgbuf->r.buf, imsgbuf->r.rptr, imsgbuf->r.wpos);
+		imsgbuf->r.rptr = imsgbuf->r.buf;
+	}
+
 	iov.iov_base = imsgbuf->r.buf + imsgbuf->r.wpos;
 	iov.iov_len = sizeof(imsgbuf->r.buf) - imsgbuf->r.wpos;
 	msg.msg_iov = &iov;
@@ -132,30 +144,30 @@ imsg_get(struct imsgbuf *imsgbuf, struct imsg *imsg)
 	struct imsg		 m;
 	size_t			 av, left, datalen;
 
-	av = imsgbuf->r.wpos;
+	av = imsgbuf->r.wpos - (imsgbuf->r.rptr - imsgbuf->r.buf);
 
 	if (IMSG_HEADER_SIZE > av)
-		return (0);
+		goto compact;
 
-	memcpy(&m.hdr, imsgbuf->r.buf, sizeof(m.hdr));
+	memcpy(&m.hdr, imsgbuf->r.rptr, sizeof(m.hdr));
 	if (m.hdr.len < IMSG_HEADER_SIZE ||
 	    m.hdr.len > MAX_IMSGSIZE) {
 		errno = ERANGE;
 		return (-1);
 	}
 	if (m.hdr.len > av)
-		return (0);
+		goto compact;
 
 	m.fd = -1;
 	m.buf = NULL;
 	m.data = NULL;
 
 	datalen = m.hdr.len - IMSG_HEADER_SIZE;
-	imsgbuf->r.rptr = imsgbuf->r.buf + IMSG_HEADER_SIZE;
 	if (datalen != 0) {
 		if ((m.buf = ibuf_open(datalen)) == NULL)
 			return (-1);
-		if (ibuf_add(m.buf, imsgbuf->r.rptr, datalen) == -1) {
+		if (ibuf_add(m.buf, imsgbuf->r.rptr + IMSG_HEADER_SIZE,
+		    datalen) == -1) {
 			/* this should never fail */
 			ibuf_free(m.buf);
 			return (-1);
@@ -166,15 +178,31 @@ imsg_get(struct imsgbuf *imsgbuf, struct imsg *imsg)
 	if (m.hdr.flags & IMSGF_HASFD)
 		m.fd = imsg_dequeue_fd(imsgbuf);
 
-	if (m.hdr.len < av) {
-		left = av - m.hdr.len;
-		memmove(&imsgbuf->r.buf, imsgbuf->r.buf + m.hdr.len, left);
-		imsgbuf->r.wpos = left;
-	} else
+	imsgbuf->r.rptr += m.hdr.len;
+	if ((size_t)(imsgbuf->r.rptr - imsgbuf->r.buf) == imsgbuf->r.wpos) {
+		imsgbuf->r.rptr = imsgbuf->r.buf;
 		imsgbuf->r.wpos = 0;
+	}
 
 	*imsg = m;
 	return (datalen + IMSG_HEADER_SIZE);
+
+compact:
+	/*
+	 * No full message is buffered.  Move what is left to the front
+	 * of the buffer now, once per batch of messages, instead of
+	 * shifting the whole buffer after every message extracted.
+	 * Readers refilling the buffer relative to r.wpos only run once
+	 * this point has been reached, so they never see consumed bytes
+	 * lingering in front of the unread data.
+	 */
+	if (imsgbuf->r.rptr > imsgbuf->r.buf) {
+		left = av;
+		memmove(imsgbuf->r.buf, imsgbuf->r.rptr, left);
+		imsgbuf->r.wpos = left;
+		imsgbuf->r.rptr = imsgbuf->r.buf;
+	}
+	return (0);
 }
 
 int
@@ -0,0 +1,216 @@
+/* compressp.c -- compress a memory buffer with multiple threads
+ * Copyright (C) 2024 The OpenBSD project
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#define ZLIB_INTERNAL
+#include "zutil.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/* Chunks smaller than this are not worth a thread of their own. */
+#define PARALLEL_MIN_CHUNK 131072
+
+/* Bytes of preceding input used to prime each chunk's dictionary. */
+#define PARALLEL_DICT_LEN 32768
+
+struct parallel_job {
+    z_const Bytef *in;          /* this chunk of the source buffer */
+    uLong in_len;
+    z_const Bytef *dict;        /* tail of the preceding chunk */
+    uInt dict_len;
+    Bytef *out;                 /* private output buffer */
+    uLong out_max;              /* capacity of out */
+    uLong out_len;              /* bytes of raw deflate data produced */
+    uLong adler;                /* Adler-32 of the input chunk */
+    int level;
+    int last;                   /* finish the stream instead of syncing */
+    int err;
+};
+
+/* ===========================================================================
+     Compress one chunk as a raw deflate stream.  Chunks after the first are
+   primed with the last PARALLEL_DICT_LEN bytes of the preceding chunk so the
+   split costs almost no ratio.  Every chunk but the last ends with an empty
+   stored block (Z_SYNC_FLUSH), which aligns it to a byte boundary so that
+   the chunks can simply be concatenated; the last chunk terminates the
+   deflate stream.
+*/
+static void *parallel_deflate(void *arg) {
+    struct parallel_job *job = arg;
+    z_stream stream;
+    const uInt max = (uInt)-1;
+    uLong left, source_len;
+    int flush, err;
+
+    left = job->out_max;
+    source_len = job->in_len;
+
+    stream.zalloc = (alloc_func)0;
+    stream.zfree = (free_func)0;
+    stream.opaque = (voidpf)0;
+
+    err = deflateInit2(&stream, job->level, Z_DEFLATED, -MAX_WBITS,
+                       DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+        job->err = err;
+        return NULL;
+    }
+    if (job->dict_len != 0) {
+        err = deflateSetDictionary(&stream, job->dict, job->dict_len);
+        if (err != Z_OK) {
+            deflateEnd(&stream);
+            job->err = err;
+            return NULL;
+        }
+    }
+
+    stream.next_out = job->out;
+    stream.avail_out = 0;
+    stream.next_in = job->in;
+    stream.avail_in = 0;
+
+    flush = job->last ? Z_FINISH : Z_SYNC_FLUSH;
+    do {
+        if (stream.avail_out == 0) {
+            stream.avail_out = left > (uLong)max ? max : (uInt)left;
+            left -= stream.avail_out;
+        }
+        if (stream.avail_in == 0) {
+            stream.avail_in = source_len > (uLong)max ? max : (uInt)source_len;
+            source_len -= stream.avail_in;
+        }
+        err = deflate(&stream, source_len ? Z_NO_FLUSH : flush);
+    } while (err == Z_OK &&
+             !(source_len == 0 && stream.avail_in == 0 &&
+               stream.avail_out != 0));
+
+    job->out_len = stream.total_out;
+    job->adler = adler32_z(adler32(0L, Z_NULL, 0), job->in,
+                           (z_size_t)job->in_len);
+    deflateEnd(&stream);
+
+    if (job->last)
+        job->err = err == Z_STREAM_END ? Z_OK :
+                   err == Z_OK ? Z_BUF_ERROR : err;
+    else
+        job->err = err;
+    return NULL;
+}
+
+/* ===========================================================================
+     Compresses the source buffer into the destination buffer, splitting the
+   work across up to nthreads threads.  Output is a single zlib stream,
+   readable by inflate() and uncompress() like the output of compress2().
+*/
+int ZEXPORT compressParallel(Bytef *dest, uLongf *destLen, const Bytef *source,
+                             uLong sourceLen, int level, int nthreads) {
+    struct parallel_job *jobs;
+    pthread_t *threads;
+    uLong chunk_len, off, total, bound;
+    unsigned header;
+    uLong adler;
+    int nchunks, i, started, err;
+
+    if (nthreads < 1 || (level != Z_DEFAULT_COMPRESSION &&
+                         (level < 0 || level > 9)))
+        return Z_STREAM_ERROR;
+
+    /* Do not split work that is too small to amortize a thread. */
+    if (sourceLen / PARALLEL_MIN_CHUNK < (uLong)nthreads)
+        nchunks = (int)(sourceLen / PARALLEL_MIN_CHUNK);
+    else
+        nchunks = nthreads;
+    if (nchunks <= 1)
+        return compress2(dest, destLen, source, sourceLen, level);
+
+    chunk_len = (sourceLen + nchunks - 1) / nchunks;
+
+    jobs = malloc(nchunks * sizeof(*jobs));
+    threads = malloc(nchunks * sizeof(*threads));
+    if (jobs == Z_NULL || threads == Z_NULL) {
+        free(jobs);
+        free(threads);
+        return Z_MEM_ERROR;
+    }
+
+    err = Z_OK;
+    for (i = 0; i < nchunks; i++) {
+        off = (uLong)i * chunk_len;
+        jobs[i].in = (z_const Bytef *)source + off;
+        jobs[i].in_len = i == nchunks - 1 ? sourceLen - off : chunk_len;
+        jobs[i].dict_len = i == 0 ? 0 :
+            (uInt)(off < PARALLEL_DICT_LEN ? off : PARALLEL_DICT_LEN);
+        jobs[i].dict = jobs[i].in - jobs[i].dict_len;
+        jobs[i].out_max = compressBound(jobs[i].in_len);
+        jobs[i].out_len = 0;
+        jobs[i].adler = 0;
+        jobs[i].level = level;
+        jobs[i].last = i == nchunks - 1;
+        jobs[i].err = Z_OK;
+        jobs[i].out = malloc(jobs[i].out_max);
+        if (jobs[i].out == Z_NULL)
+            err = Z_MEM_ERROR;
+    }
+
+    started = 0;
+    if (err == Z_OK) {
+        for (i = 0; i < nchunks; i++) {
+            if (pthread_create(&threads[i], NULL, parallel_deflate,
+                               &jobs[i]) != 0) {
+                err = Z_MEM_ERROR;
+                break;
+            }
+            started++;
+        }
+    }
+    for (i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    for (i = 0; i < started && err == Z_OK; i++)
+        err = jobs[i].err;
+
+    if (err == Z_OK) {
+        /* zlib header, as deflate() would emit it (RFC 1950). */
+        if (level == Z_DEFAULT_COMPRESSION || level == 6)
+            header = (0x78 << 8) + (2 << 6);
+        else if (level < 2)
+            header = (0x78 << 8) + (0 << 6);
+        else if (level < 6)
+            header = (0x78 << 8) + (1 << 6);
+        else
+            header = (0x78 << 8) + (3 << 6);
+        header += 31 - (header % 31);
+
+        total = 2;
+        for (i = 0; i < nchunks; i++)
+            total += jobs[i].out_len;
+        total += 4;
+
+        if (total > *destLen) {
+            err = Z_BUF_ERROR;
+        } else {
+            dest[0] = (Bytef)(header >> 8);
+            dest[1] = (Bytef)(header & 0xff);
+            bound = 2;
+            adler = adler32(0L, Z_NULL, 0);
+            for (i = 0; i < nchunks; i++) {
+                zmemcpy(dest + bound, jobs[i].out, jobs[i].out_len);
+                bound += jobs[i].out_len;
+                adler = adler32_combine(adler, jobs[i].adler,
+                                        (z_off_t)jobs[i].in_len);
+            }
+            dest[bound]     = (Bytef)(adler >> 24);
+            dest[bound + 1] = (Bytef)(adler >> 16);
+            dest[bound + 2] = (Bytef)(adler >> 8);
+            dest[bound + 3] = (Bytef)adler;
+            *destLen = total;
+        }
+    }
+
+    for (i = 0; i < nchunks; i++)
+        free(jobs[i].out);
+    free(jobs);
+    free(threads);
+    return err;
+}
@@ -99,6 +99,20 @@
 /* If available, use the ARM processor CRC32 instruction. */
 #if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32) && W == 8
 #  define ARMCRC32
+#elif defined(__aarch64__) && defined(__OpenBSD__) && W == 8
+   /* The baseline compilation target lacks the CRC32 extension, but the
+      kernel exports the CPU identification registers, so compile the
+      instruction version as well and select it at run time. */
+#  define ARMCRC32_CHECK
+#endif
+
+#ifdef ARMCRC32_CHECK
+#  include <sys/types.h>
+#  include <sys/sysctl.h>
+#  include <machine/cpu.h>	/* for CPU_ID_AA64ISAR0 */
+#  ifndef CPU_ID_AA64ISAR0
+#    undef ARMCRC32_CHECK
+#  endif
 #endif
 
 #if defined(W) && (!defined(ARMCRC32) || defined(DYNAMIC_CRC_TABLE))
@@ -560,7 +574,7 @@ const z_crc_t FAR * ZEXPORT get_crc_table(void) {
  * -march=armv8-a+crc, or -march=native if the compile machine has the crc32
  * instructions.
  */
-#ifdef ARMCRC32
+#if defined(ARMCRC32) || defined(ARMCRC32_CHECK)
 
 /*
    Constants empirically determined to maximize speed. These values are from
@@ -570,8 +584,32 @@ const z_crc_t FAR * ZEXPORT get_crc_table(void) {
 #define Z_BATCH_ZEROS 0xa10d3d0c    /* computed from Z_BATCH = 3990 */
 #define Z_BATCH_MIN 800             /* fewest words in a final batch */
 
+#ifdef ARMCRC32_CHECK
+/*
+  Return 1 if the CPU implements the CRC32 extension, reading the (kernel
+  emulated) ID_AA64ISAR0_EL1 register via sysctl. The result is cached.
+ */
+local int armcrc32_available(void) {
+    static int avail = -1;
+
+    if (avail < 0) {
+        int mib[] = { CTL_MACHDEP, CPU_ID_AA64ISAR0 };
+        uint64_t isar0 = 0;
+        size_t size = sizeof(isar0);
+
+        avail = sysctl(mib, 2, &isar0, &size, NULL, 0) == 0 &&
+                ((isar0 >> 16) & 0xf) != 0;     /* ID_AA64ISAR0_EL1.CRC32 */
+    }
+    return avail;
+}
+
+__attribute__((target("+crc")))
+local unsigned long armcrc32_z(unsigned long crc,
+                               const unsigned char FAR *buf, z_size_t len) {
+#else
 unsigned long ZEXPORT crc32_z(unsigned long crc, const unsigned char FAR *buf,
                               z_size_t len) {
+#endif
     z_crc_t val;
     z_word_t crc1, crc2;
     const z_word_t *word;
@@ -662,7 +700,9 @@ unsigned long ZEXPORT crc32_z(unsigned long crc, const unsigned char FAR *buf,
     return crc ^ 0xffffffff;
 }
 
-#else
+#endif
+
+#ifndef ARMCRC32
 
 #ifdef W
 
@@ -694,6 +734,11 @@ unsigned long ZEXPORT crc32_z(unsigned long crc, const unsigned char FAR *buf,
     /* Return initial CRC, if requested. */
     if (buf == Z_NULL) return 0;
 
+#ifdef ARMCRC32_CHECK
+    if (armcrc32_available())
+        return armcrc32_z(crc, buf, len);
+#endif
+
 #ifdef DYNAMIC_CRC_TABLE
     once(&made, make_crc_table);
 #endif /* DYNAMIC_CRC_TABLE */
@@ -1270,6 +1270,25 @@ ZEXTERN uLong ZEXPORT compressBound(uLong sourceLen);
    compress() or compress2() call to allocate the destination buffer.
 */
 
+ZEXTERN int ZEXPORT compressParallel(Bytef *dest, uLongf *destLen,
+                                     const Bytef *source, uLong sourceLen,
+                                     int level, int nthreads);
+/*
+     Same as compress2(), but splits the source buffer into chunks that are
+   compressed concurrently by up to nthreads threads and stitched back
+   together.  The result is a single zlib stream that inflate() and
+   uncompress() accept, at a slightly worse ratio than compress2() since
+   each chunk ends on a byte boundary.  Small buffers are compressed on the
+   calling thread.  This only helps one-shot compression of buffers large
+   enough to amortize the threads; the streaming deflate() interface is
+   unaffected.
+
+     compressParallel returns Z_OK if success, Z_MEM_ERROR if there was not
+   enough memory or a thread could not be created, Z_BUF_ERROR if there was
+   not enough room in the output buffer, Z_STREAM_ERROR if the level or
+   nthreads parameter is invalid.
+*/
+
 ZEXTERN int ZEXPORT uncompress(Bytef *dest,   uLongf *destLen,
                                const Bytef *source, uLong sourceLen);
 /*
@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <event.h>
 
@@ -72,9 +73,12 @@ struct kif_node {
 	RB_ENTRY(kif_node)	 entry;
 	TAILQ_HEAD(, kif_addr)	 addrs;
 	TAILQ_HEAD(, kif_arp)	 arps;
+	time_t			 lastfetch;
 	struct kif		 k;
 };
 
+#define	KIF_REFRESH	1	/* seconds before counters go stale */
+
 int	kroute_compare(struct kroute_node *, struct kroute_node *);
 int	kroute6_compare(struct kroute6_node *, struct kroute6_node *);
 int	kif_compare(struct kif_node *, struct kif_node *);
@@ -364,7 +368,26 @@ kr_iflastchange(void)
 int
 kr_updateif(u_int if_index)
 {
-	return (fetchifs(if_index));
+	struct kif_node	*kif;
+	struct timespec	 ts;
+
+	/*
+	 * A table walk asks for the same interface once per column;
+	 * configuration changes arrive over the routing socket, so
+	 * between fetches only the counters age.  Skip the sysctl
+	 * round-trip if this interface was fetched very recently.
+	 */
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	if (if_index != 0 && (kif = kif_find(if_index)) != NULL &&
+	    ts.tv_sec - kif->lastfetch < KIF_REFRESH)
+		return (0);
+
+	if (fetchifs(if_index) == -1)
+		return (-1);
+
+	if (if_index != 0 && (kif = kif_find(if_index)) != NULL)
+		kif->lastfetch = ts.tv_sec;
+	return (0);
 }
 
 u_long
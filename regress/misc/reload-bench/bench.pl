@@ -0,0 +1,26 @@
+#!/usr/bin/perl
+#	$OpenBSD$
+
+# Run a command several times and report the best wall-clock time on a
+# single machine-parseable line.  The best of several runs is the least
+# noisy estimate of how fast the code can go on this machine.
+
+use strict;
+use warnings;
+use Time::HiRes qw(time);
+
+my $runs = 5;
+my $name = shift
+    or die "usage: bench.pl name command [argument ...]\n";
+@ARGV
+    or die "usage: bench.pl name command [argument ...]\n";
+
+my $best;
+foreach (1 .. $runs) {
+	my $t0 = time();
+	system(@ARGV) == 0
+	    or die "$name: '@ARGV' failed: $?\n";
+	my $ms = (time() - $t0) * 1000;
+	$best = $ms if !defined($best) || $ms < $best;
+}
+printf("BENCH %s runs=%d best_ms=%.1f\n", $name, $runs, $best);
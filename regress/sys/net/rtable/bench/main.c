@@ -0,0 +1,127 @@
+/*	$OpenBSD$ */
+
+/*
+ * Public domain.
+ *
+ * Microbenchmark for the single-lookup cost of the routing table.
+ * Load a full feed, collect the destination of every route, then
+ * time rtable_match() over the destinations in random order.  One
+ * machine-parseable line is printed:
+ *
+ *	BENCH rtable-match-<af> routes=<n> lookups=<n> misses=<n> \
+ *	    ns_per_lookup=<ns>
+ *
+ * The numbers are only meaningful relative to earlier runs on the
+ * same machine; the benchmark never fails on slow results.
+ */
+
+#include "srp_compat.h"
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <net/route.h>
+#include <net/rtable.h>
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "util.h"
+
+#define NROUNDS	32	/* passes over the collected destinations */
+
+struct dstlist {
+	struct sockaddr	**dl_dst;
+	unsigned int	  dl_ndst;
+	unsigned int	  dl_sz;
+};
+
+__dead void
+usage(void)
+{
+	extern const char *__progname;
+	fprintf(stderr, "Usage: %s [inet|inet6] <file>\n", __progname);
+	exit(1);
+}
+
+int
+collect_dst(struct rtentry *rt, void *arg, unsigned int rtableid)
+{
+	struct dstlist *dl = arg;
+	struct sockaddr **dst;
+
+	if (dl->dl_ndst >= dl->dl_sz) {
+		dl->dl_sz = dl->dl_sz ? 2 * dl->dl_sz : 1024;
+		dst = reallocarray(dl->dl_dst, dl->dl_sz, sizeof(*dst));
+		if (dst == NULL)
+			err(1, "reallocarray");
+		dl->dl_dst = dst;
+	}
+	dl->dl_dst[dl->dl_ndst++] = rt_key(rt);
+
+	return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+	struct dstlist dl;
+	struct timespec start, end, diff;
+	struct rtentry *rt;
+	struct sockaddr *tmp;
+	char *filename;
+	unsigned long long ns;
+	unsigned int i, j, nlookups, misses;
+	sa_family_t af;
+
+	if (argc != 3)
+		usage();
+
+	af = strncmp(argv[1], "inet6", 5) ? AF_INET : AF_INET6;
+	filename = argv[2];
+
+	rtable_init();
+
+	do_from_file(0, af, filename, route_insert);
+
+	memset(&dl, 0, sizeof(dl));
+	rtable_walk(0, af, NULL, collect_dst, &dl);
+	if (dl.dl_ndst == 0)
+		errx(1, "no routes");
+
+	/*
+	 * Shuffle the destinations so that the lookups do not simply
+	 * replay the in-order walk of the tree.
+	 */
+	for (i = dl.dl_ndst - 1; i > 0; i--) {
+		j = arc4random_uniform(i + 1);
+		tmp = dl.dl_dst[i];
+		dl.dl_dst[i] = dl.dl_dst[j];
+		dl.dl_dst[j] = tmp;
+	}
+
+	misses = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < NROUNDS; i++) {
+		for (j = 0; j < dl.dl_ndst; j++) {
+			rt = rtable_match(0, dl.dl_dst[j], NULL);
+			if (rt == NULL)
+				misses++;
+			else
+				rtfree(rt);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	timespecsub(&end, &start, &diff);
+	nlookups = NROUNDS * dl.dl_ndst;
+	ns = diff.tv_sec * 1000000000ULL + diff.tv_nsec;
+
+	printf("BENCH rtable-match-%s routes=%u lookups=%u misses=%u "
+	    "ns_per_lookup=%llu\n", argv[1], dl.dl_ndst, nlookups, misses,
+	    ns / nlookups);
+
+	return (0);
+}
@@ -234,4 +234,22 @@ sshbuf_tests(void)
 	ASSERT_SIZE_T_EQ(sshbuf_avail(p1), 1223);
 	sshbuf_free(p1);
 	TEST_DONE();
+
+	/* NB. uses sshbuf internals */
+	TEST_START("reset buffer keeping allocation");
+	p1 = sshbuf_new();
+	ASSERT_PTR_NE(p1, NULL);
+	r = sshbuf_reserve(p1, 1223, &dp);
+	ASSERT_INT_EQ(r, 0);
+	ASSERT_PTR_NE(dp, NULL);
+	memset(dp, 0xd7, 1223);
+	sz = sshbuf_alloc(p1);
+	sshbuf_reset_keepalloc(p1);
+	ASSERT_SIZE_T_EQ(sshbuf_len(p1), 0);
+	ASSERT_SIZE_T_EQ(sshbuf_alloc(p1), sz);
+	cdp = sshbuf_ptr(p1);
+	ASSERT_PTR_NE(cdp, NULL);
+	ASSERT_MEM_ZERO_EQ(cdp, sz);
+	sshbuf_free(p1);
+	TEST_DONE();
 }
@@ -43,8 +43,8 @@
 
 #define	MAXDUP		10	/* limit on dup blks (per inode) */
 #define	MAXBAD		10	/* limit on bad blks (per inode) */
-#define	MAXBUFSPACE	40*1024	/* maximum space to allocate to buffers */
-#define	INOBUFSIZE	56*1024	/* size of buffer to read inodes in pass1 */
+#define	MAXBUFSPACE	4*1024*1024	/* maximum space to allocate to buffers */
+#define	INOBUFSIZE	512*1024 /* size of buffer to read inodes in pass1 */
 
 union dinode {
 	struct ufs1_dinode dp1;
@@ -127,6 +127,8 @@ int	fsi, fso;
 
 static caddr_t iobuf;
 static long iobufsize;
+static caddr_t inobuf;
+static long inobufsize;
 
 daddr_t	alloc(int, int);
 static int	charsperline(void);
@@ -553,6 +555,16 @@ mkfs(struct partition *pp, char *fsys, int fi, int fo, mode_t mfsmode,
 	if ((iobuf = malloc(iobufsize)) == NULL)
 		errx(38, "cannot allocate I/O buffer");
 	bzero(iobuf, iobufsize);
+	if (Oflag <= 1) {
+		/*
+		 * FFS1 initializes the whole inode table up front; do it
+		 * a buffer full of blocks at a time instead of block by
+		 * block.
+		 */
+		inobufsize = MAXIMUM(MAXBSIZE, 4 * sblock.fs_bsize);
+		if ((inobuf = calloc(1, inobufsize)) == NULL)
+			errx(38, "cannot allocate inode buffer");
+	}
 	/*
 	 * Make a copy of the superblock into the buffer that we will be
 	 * writing out in each cylinder group.
@@ -621,7 +633,7 @@ mkfs(struct partition *pp, char *fsys, int fi, int fo, mode_t mfsmode,
 void
 initcg(u_int cg, time_t utime)
 {
-	u_int i, j, d, dlower, dupper, blkno, start;
+	u_int i, j, n, d, dlower, dupper, blkno, start;
 	daddr_t cbase, dmax;
 	struct ufs1_dinode *dp1;
 	struct ufs2_dinode *dp2;
@@ -752,17 +764,19 @@ initcg(u_int cg, time_t utime)
 	wtfs(fsbtodb(&sblock, cgsblock(&sblock, cg)), iobufsize, iobuf);
 
 	if (Oflag <= 1) {
-		/* Initialize inodes for FFS1. */
+		/* Initialize inodes for FFS1, a buffer full at a time. */
 		for (i = 2 * sblock.fs_frag;
 		    i < sblock.fs_ipg / INOPF(&sblock);
-		    i += sblock.fs_frag) {
-			dp1 = (struct ufs1_dinode *)(&iobuf[start]);
-			for (j = 0; j < INOPB(&sblock); j++) {
+		    i += n) {
+			n = MINIMUM(inobufsize / sblock.fs_fsize,
+			    sblock.fs_ipg / INOPF(&sblock) - i);
+			dp1 = (struct ufs1_dinode *)inobuf;
+			for (j = 0; j < n * INOPF(&sblock); j++) {
 				dp1->di_gen = arc4random();
 				dp1++;
 			}
 			wtfs(fsbtodb(&sblock, cgimin(&sblock, cg) + i),
-			    sblock.fs_bsize, &iobuf[start]);
+			    n * sblock.fs_fsize, inobuf);
 		}
 	}
 }
@@ -81,6 +81,8 @@ struct node_host	*host_if(const char *, int);
 struct node_host	*host_ip(const char *, int);
 struct node_host	*host_dns(const char *, int, int);
 
+int		 append_addr_plain(struct pfr_buffer *, const char *, int, int);
+
 const char *tcpflags = "FSRPAUEW";
 
 static const struct icmptypeent icmp_type[] = {
@@ -1800,6 +1802,45 @@ error:
 	return (h);
 }
 
+/*
+ * append a plain numeric address, with an optional prefix length, to the
+ * given buffer. Returns -1 if the string is anything else; the caller then
+ * falls back to the full host() lookup.
+ */
+int
+append_addr_plain(struct pfr_buffer *b, const char *s, int test, int not)
+{
+	struct pfr_addr	 addr;
+	char		 buf[48];	/* fits the longest IPv6 address */
+	const char	*errstr, *p;
+	int		 bits, mask = -1;
+
+	if ((p = strchr(s, '/')) != NULL) {
+		if ((size_t)(p - s) >= sizeof(buf))
+			return (-1);
+		memcpy(buf, s, p - s);
+		buf[p - s] = '\0';
+		mask = strtonum(p + 1, 0, 128, &errstr);
+		if (errstr)
+			return (-1);
+		s = buf;
+	}
+	bzero(&addr, sizeof(addr));
+	if (inet_pton(AF_INET, s, &addr.pfra_ip4addr) == 1) {
+		addr.pfra_af = AF_INET;
+		bits = 32;
+	} else if (inet_pton(AF_INET6, s, &addr.pfra_ip6addr) == 1) {
+		addr.pfra_af = AF_INET6;
+		bits = 128;
+	} else
+		return (-1);
+	if (mask > bits || (test && (not || (mask != -1 && mask != bits))))
+		return (-1);
+	addr.pfra_not = not;
+	addr.pfra_net = (mask == -1) ? bits : mask;
+	return (pfr_buf_add(b, &addr));
+}
+
 /*
  * convert a hostname to a list of addresses and put them in the given buffer.
  * test:
@@ -1845,6 +1886,15 @@ append_addr(struct pfr_buffer *b, char *s, int test, int opts)
 
 	for (r = s; *r == '!'; r++)
 		not = !not;
+	/*
+	 * Plain addresses are by far the most common content of table
+	 * files; adding them directly avoids a round of allocations and
+	 * interface and resolver lookups in host() for every entry.
+	 */
+	if (append_addr_plain(b, r, test, not) == 0) {
+		previous = b->pfrb_size;
+		return (0);
+	}
 	if ((n = host(r, opts)) == NULL) {
 		errno = 0;
 		return (-1);
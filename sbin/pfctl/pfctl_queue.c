@@ -226,6 +226,8 @@ pfctl_print_queue_nodestat(int dev, const struct pfctl_queue_node *node)
 		printf("  [ qlength: %3d/%3d  avg delay: %.3fms std-dev: %.3fms"
 		    "  flows: %3d ]\n", stats->qlength, stats->qlimit,
 		    avg / 1000, dev / 1000, fqstats->flows);
+		printf("  [ target: %.1fms  interval: %.1fms ]\n",
+		    fqstats->target / 1000.0, fqstats->interval / 1000.0);
 	} else
 		printf("  [ qlength: %3d/%3d ]\n", stats->qlength,
 		    stats->qlimit);
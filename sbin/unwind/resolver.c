@@ -1667,7 +1667,12 @@ schedule_recheck_all_resolvers(void)
 	for (i = 0; i < UW_RES_NONE; i++) {
 		if (resolvers[i] == NULL)
 			continue;
-		tv.tv_usec = arc4random() % 1000000; /* modulo bias is ok */
+		/*
+		 * Just a bit of jitter to keep the probes apart; this runs
+		 * when the network changed, so every tick spent waiting
+		 * here prolongs the outage for pending queries.
+		 */
+		tv.tv_usec = arc4random() % 100000; /* modulo bias is ok */
 		resolvers[i]->state = UNKNOWN;
 		evtimer_add(&resolvers[i]->check_ev, &tv);
 	}
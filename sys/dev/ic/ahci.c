@@ -33,6 +33,14 @@
 #include <dev/ic/ahcireg.h>
 #include <dev/ic/ahcivar.h>
 
+/* extra passes over the global interrupt status before leaving ahci_intr */
+#define AHCI_INTR_POLL_TRIES	3
+
+#ifdef AHCI_COALESCE
+/* interrupts between re-evaluations of the coalescing threshold */
+#define AHCI_CCC_ADAPT_INTRS	64
+#endif
+
 #ifdef AHCI_DEBUG
 #define DPRINTF(m, f...) do { if ((ahcidebug & (m)) == (m)) printf(f); } \
     while (0)
@@ -104,6 +112,9 @@ void			ahci_issue_pending_commands(struct ahci_port *, int);
 
 int			ahci_intr(void *);
 u_int32_t		ahci_port_intr(struct ahci_port *, u_int32_t);
+#ifdef AHCI_COALESCE
+void			ahci_coalesce_adapt(struct ahci_softc *, u_int);
+#endif
 
 struct ahci_ccb		*ahci_get_ccb(struct ahci_port *);
 void			ahci_put_ccb(struct ahci_ccb *);
@@ -256,6 +267,11 @@ ahci_attach(struct ahci_softc *sc)
 		ahci_write(sc, AHCI_REG_CCC_CTL, ccc_ctl);
 		ahci_write(sc, AHCI_REG_CCC_PORTS, 0);
 		ahci_write(sc, AHCI_REG_CCC_CTL, ccc_ctl | 1);
+
+		/* remembered so the threshold can be adapted to the load. */
+		sc->sc_ccc_ctl = ccc_ctl;
+		sc->sc_ccc_intrs = 0;
+		sc->sc_ccc_cmds = 0;
 	}
 noccc:
 #endif
@@ -2000,40 +2016,117 @@ int
 ahci_intr(void *arg)
 {
 	struct ahci_softc		*sc = arg;
-	u_int32_t			is, ack = 0;
+	u_int32_t			is, ack;
 	int				port;
+	int				tries = AHCI_INTR_POLL_TRIES;
+#ifdef AHCI_COALESCE
+	u_int32_t			processed;
+	u_int				ncmds = 0;
+#endif
 
 	/* Read global interrupt status */
 	is = ahci_read(sc, AHCI_REG_IS);
 	if (is == 0 || is == 0xffffffff)
 		return (0);
-	ack = is;
+
+	for (;;) {
+		ack = is;
 
 #ifdef AHCI_COALESCE
-	/* Check coalescing interrupt first */
-	if (is & sc->sc_ccc_mask) {
-		DPRINTF(AHCI_D_INTR, "%s: command coalescing interrupt\n",
-		    DEVNAME(sc));
-		is &= ~sc->sc_ccc_mask;
-		is |= sc->sc_ccc_ports_cur;
-	}
+		/* Check coalescing interrupt first */
+		if (is & sc->sc_ccc_mask) {
+			DPRINTF(AHCI_D_INTR, "%s: command coalescing "
+			    "interrupt\n", DEVNAME(sc));
+			is &= ~sc->sc_ccc_mask;
+			is |= sc->sc_ccc_ports_cur;
+		}
 #endif
 
-	/* Process interrupts for each port */
-	while (is) {
-		port = ffs(is) - 1;
-		if (sc->sc_ports[port])
-			ahci_port_intr(sc->sc_ports[port],
-			    AHCI_PREG_CI_ALL_SLOTS);
-		is &= ~(1 << port);
+		/* Process interrupts for each port */
+		while (is) {
+			port = ffs(is) - 1;
+			if (sc->sc_ports[port]) {
+#ifdef AHCI_COALESCE
+				processed = ahci_port_intr(sc->sc_ports[port],
+				    AHCI_PREG_CI_ALL_SLOTS);
+				while (processed != 0) {
+					processed &= processed - 1;
+					ncmds++;
+				}
+#else
+				ahci_port_intr(sc->sc_ports[port],
+				    AHCI_PREG_CI_ALL_SLOTS);
+#endif
+			}
+			is &= ~(1 << port);
+		}
+
+		/* Acknowledge global interrupt */
+		ahci_write(sc, AHCI_REG_IS, ack);
+
+		/*
+		 * Commands that completed while the ones above were
+		 * drained can be picked up right away, saving the cost
+		 * of another interrupt for them.
+		 */
+		if (--tries == 0)
+			break;
+		is = ahci_read(sc, AHCI_REG_IS);
+		if (is == 0 || is == 0xffffffff)
+			break;
 	}
 
-	/* Finally, acknowledge global interrupt */
-	ahci_write(sc, AHCI_REG_IS, ack);
+#ifdef AHCI_COALESCE
+	ahci_coalesce_adapt(sc, ncmds);
+#endif
 
 	return (1);
 }
 
+#ifdef AHCI_COALESCE
+/*
+ * Nudge the coalescing completion threshold towards the number of
+ * commands that finish per interrupt, so a busy controller batches
+ * more completions while a mostly idle one is not taxed with the
+ * extra latency.
+ */
+void
+ahci_coalesce_adapt(struct ahci_softc *sc, u_int ncmds)
+{
+	u_int32_t			ccc_ctl;
+	u_int				avg, thresh;
+
+	if (sc->sc_ccc_mask == 0)
+		return;
+
+	sc->sc_ccc_intrs++;
+	sc->sc_ccc_cmds += ncmds;
+	if (sc->sc_ccc_intrs < AHCI_CCC_ADAPT_INTRS)
+		return;
+
+	avg = sc->sc_ccc_cmds / sc->sc_ccc_intrs;
+	sc->sc_ccc_intrs = 0;
+	sc->sc_ccc_cmds = 0;
+
+	ccc_ctl = sc->sc_ccc_ctl;
+	thresh = (ccc_ctl >> 8) & 0xff;
+	if (avg >= thresh && thresh < sc->sc_ncmds)
+		thresh++;
+	else if (avg < thresh / 2 && thresh > 1)
+		thresh--;
+	else
+		return;
+
+	ccc_ctl &= ~0x0000ff00;
+	ccc_ctl |= thresh << 8;
+	sc->sc_ccc_ctl = ccc_ctl;
+
+	/* coalescing must be off while the threshold is rewritten. */
+	ahci_write(sc, AHCI_REG_CCC_CTL, ccc_ctl);
+	ahci_write(sc, AHCI_REG_CCC_CTL, ccc_ctl | 1);
+}
+#endif
+
 u_int32_t
 ahci_port_intr(struct ahci_port *ap, u_int32_t ci_mask)
 {
@@ -138,6 +138,9 @@ struct ahci_softc {
 	u_int32_t		sc_ccc_mask;
 	u_int32_t		sc_ccc_ports;
 	u_int32_t		sc_ccc_ports_cur;
+	u_int32_t		sc_ccc_ctl;
+	u_int			sc_ccc_intrs;
+	u_int			sc_ccc_cmds;
 #endif
 
 	int			(*sc_port_start)(struct ahci_port *, int);
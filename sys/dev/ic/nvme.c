@@ -29,6 +29,7 @@
 #include <sys/atomic.h>
 
 #include <machine/bus.h>
+#include <machine/cpu.h>
 
 #include <scsi/scsi_all.h>
 #include <scsi/scsi_disk.h>
@@ -68,6 +69,11 @@ void	nvme_sqe_fill(struct nvme_softc *, struct nvme_ccb *, void *);
 void	nvme_empty_done(struct nvme_softc *, struct nvme_ccb *,
 	    struct nvme_cqe *);
 
+u_int	nvme_set_nqueues(struct nvme_softc *, u_int);
+void	nvme_feat_fill(struct nvme_softc *, struct nvme_ccb *, void *);
+void	nvme_feat_done(struct nvme_softc *, struct nvme_ccb *,
+	    struct nvme_cqe *);
+
 struct nvme_queue *
 	nvme_q_alloc(struct nvme_softc *, u_int16_t, u_int, u_int);
 int	nvme_q_create(struct nvme_softc *, struct nvme_queue *);
@@ -277,6 +283,7 @@ nvme_attach(struct nvme_softc *sc)
 	u_int64_t cap;
 	u_int32_t reg;
 	u_int nccbs = 0;
+	u_int i;
 
 	mtx_init(&sc->sc_ccb_mtx, IPL_BIO);
 	SIMPLEQ_INIT(&sc->sc_ccb_list);
@@ -346,19 +353,32 @@ nvme_attach(struct nvme_softc *sc)
 	}
 	nccbs = 64;
 
-	sc->sc_q = nvme_q_alloc(sc, NVME_IO_Q, 128, sc->sc_dstrd);
-	if (sc->sc_q == NULL) {
-		printf("%s: unable to allocate io q\n", DEVNAME(sc));
-		goto disable;
-	}
+	sc->sc_nq = nvme_set_nqueues(sc, MIN(NVME_MAXQ, ncpus));
 
-	if (nvme_q_create(sc, sc->sc_q) != 0) {
-		printf("%s: unable to create io q\n", DEVNAME(sc));
-		goto free_q;
+	for (i = 0; i < sc->sc_nq; i++) {
+		sc->sc_q[i] = nvme_q_alloc(sc, NVME_IO_Q + i, 128,
+		    sc->sc_dstrd);
+		if (sc->sc_q[i] != NULL &&
+		    nvme_q_create(sc, sc->sc_q[i]) != 0) {
+			nvme_q_free(sc, sc->sc_q[i]);
+			sc->sc_q[i] = NULL;
+		}
+		if (sc->sc_q[i] == NULL) {
+			if (i == 0) {
+				printf("%s: unable to create io q\n",
+				    DEVNAME(sc));
+				goto disable;
+			}
+
+			/* run with the queues we managed to create */
+			sc->sc_nq = i;
+			break;
+		}
 	}
 
 #ifdef HIBERNATE
-	sc->sc_hib_q = nvme_q_alloc(sc, NVME_HIB_Q, 4, sc->sc_dstrd);
+	sc->sc_hib_q = nvme_q_alloc(sc, NVME_IO_Q + sc->sc_nq, 4,
+	    sc->sc_dstrd);
 	if (sc->sc_hib_q == NULL) {
 		printf("%s: unable to allocate hibernate io queue\n", DEVNAME(sc));
 		goto free_q;
@@ -385,7 +405,11 @@ nvme_attach(struct nvme_softc *sc)
 	return (0);
 
 free_q:
-	nvme_q_free(sc, sc->sc_q);
+	while (sc->sc_nq > 0) {
+		sc->sc_nq--;
+		nvme_q_free(sc, sc->sc_q[sc->sc_nq]);
+		sc->sc_q[sc->sc_nq] = NULL;
+	}
 disable:
 	nvme_disable(sc);
 free_ccbs:
@@ -399,6 +423,8 @@ free_admin_q:
 int
 nvme_resume(struct nvme_softc *sc)
 {
+	u_int i;
+
 	if (nvme_disable(sc) != 0) {
 		printf("%s: unable to disable controller\n", DEVNAME(sc));
 		return (1);
@@ -414,15 +440,22 @@ nvme_resume(struct nvme_softc *sc)
 		return (1);
 	}
 
-	sc->sc_q = nvme_q_alloc(sc, NVME_IO_Q, 128, sc->sc_dstrd);
-	if (sc->sc_q == NULL) {
-		printf("%s: unable to allocate io q\n", DEVNAME(sc));
-		goto disable;
-	}
+	sc->sc_nq = nvme_set_nqueues(sc, sc->sc_nq);
 
-	if (nvme_q_create(sc, sc->sc_q) != 0) {
-		printf("%s: unable to create io q\n", DEVNAME(sc));
-		goto free_q;
+	for (i = 0; i < sc->sc_nq; i++) {
+		sc->sc_q[i] = nvme_q_alloc(sc, NVME_IO_Q + i, 128,
+		    sc->sc_dstrd);
+		if (sc->sc_q[i] == NULL) {
+			printf("%s: unable to allocate io q\n", DEVNAME(sc));
+			goto free_q;
+		}
+
+		if (nvme_q_create(sc, sc->sc_q[i]) != 0) {
+			printf("%s: unable to create io q\n", DEVNAME(sc));
+			nvme_q_free(sc, sc->sc_q[i]);
+			sc->sc_q[i] = NULL;
+			goto free_q;
+		}
 	}
 
 	nvme_write4(sc, NVME_INTMC, 1);
@@ -430,7 +463,11 @@ nvme_resume(struct nvme_softc *sc)
 	return (0);
 
 free_q:
-	nvme_q_free(sc, sc->sc_q);
+	while (i > 0) {
+		i--;
+		nvme_q_free(sc, sc->sc_q[i]);
+		sc->sc_q[i] = NULL;
+	}
 disable:
 	nvme_disable(sc);
 
@@ -495,9 +532,13 @@ nvme_shutdown(struct nvme_softc *sc)
 
 	nvme_write4(sc, NVME_INTMC, 0);
 
-	if (nvme_q_delete(sc, sc->sc_q) != 0) {
-		printf("%s: unable to delete q, disabling\n", DEVNAME(sc));
-		goto disable;
+	for (i = 0; i < sc->sc_nq; i++) {
+		if (nvme_q_delete(sc, sc->sc_q[i]) != 0) {
+			printf("%s: unable to delete q, disabling\n",
+			    DEVNAME(sc));
+			goto disable;
+		}
+		sc->sc_q[i] = NULL;
 	}
 
 	cc = nvme_read4(sc, NVME_CC);
@@ -607,6 +648,7 @@ nvme_scsi_io(struct scsi_xfer *xs, int dir)
 	struct nvme_softc *sc = link->bus->sb_adapter_softc;
 	struct nvme_ccb *ccb = xs->io;
 	bus_dmamap_t dmap = ccb->ccb_dmamap;
+	struct nvme_queue *q = sc->sc_q[cpu_number() % sc->sc_nq];
 	int i;
 
 	if ((xs->flags & (SCSI_DATA_IN|SCSI_DATA_OUT)) != dir)
@@ -637,11 +679,11 @@ nvme_scsi_io(struct scsi_xfer *xs, int dir)
 	}
 
 	if (ISSET(xs->flags, SCSI_POLL)) {
-		nvme_poll(sc, sc->sc_q, ccb, nvme_scsi_io_fill);
+		nvme_poll(sc, q, ccb, nvme_scsi_io_fill);
 		return;
 	}
 
-	nvme_q_submit(sc, sc->sc_q, ccb, nvme_scsi_io_fill);
+	nvme_q_submit(sc, q, ccb, nvme_scsi_io_fill);
 	return;
 
 stuffup:
@@ -719,16 +761,17 @@ nvme_scsi_sync(struct scsi_xfer *xs)
 	struct scsi_link *link = xs->sc_link;
 	struct nvme_softc *sc = link->bus->sb_adapter_softc;
 	struct nvme_ccb *ccb = xs->io;
+	struct nvme_queue *q = sc->sc_q[cpu_number() % sc->sc_nq];
 
 	ccb->ccb_done = nvme_scsi_sync_done;
 	ccb->ccb_cookie = xs;
 
 	if (ISSET(xs->flags, SCSI_POLL)) {
-		nvme_poll(sc, sc->sc_q, ccb, nvme_scsi_sync_fill);
+		nvme_poll(sc, q, ccb, nvme_scsi_sync_fill);
 		return;
 	}
 
-	nvme_q_submit(sc, sc->sc_q, ccb, nvme_scsi_sync_fill);
+	nvme_q_submit(sc, q, ccb, nvme_scsi_sync_fill);
 }
 
 void
@@ -1029,6 +1072,74 @@ nvme_empty_done(struct nvme_softc *sc, struct nvme_ccb *ccb,
 {
 }
 
+struct nvme_feat_state {
+	struct nvme_sqe s;
+	u_int32_t cdw0;
+};
+
+void
+nvme_feat_fill(struct nvme_softc *sc, struct nvme_ccb *ccb, void *slot)
+{
+	struct nvme_sqe *sqe = slot;
+	struct nvme_feat_state *state = ccb->ccb_cookie;
+
+	*sqe = state->s;
+}
+
+void
+nvme_feat_done(struct nvme_softc *sc, struct nvme_ccb *ccb,
+    struct nvme_cqe *cqe)
+{
+	struct nvme_feat_state *state = ccb->ccb_cookie;
+
+	state->cdw0 = lemtoh32(&cqe->cdw0);
+}
+
+/*
+ * Ask the controller for nq I/O queue pairs plus one the hibernate code
+ * can create later on. Returns how many pairs may actually be created,
+ * which on failure is the single pair every controller has to support.
+ */
+u_int
+nvme_set_nqueues(struct nvme_softc *sc, u_int nq)
+{
+	struct nvme_feat_state state;
+	struct nvme_ccb *ccb;
+	u_int nsqa, ncqa;
+	int rv;
+
+	ccb = scsi_io_get(&sc->sc_iopool, 0);
+	KASSERT(ccb != NULL);
+
+	memset(&state, 0, sizeof(state));
+	state.s.opcode = NVM_ADMIN_SET_FEATURES;
+	htolem32(&state.s.cdw10, NVM_FEAT_NUMBER_OF_QUEUES);
+	/* the values are zero based */
+	htolem32(&state.s.cdw11, (nq << 16) | nq);
+
+	ccb->ccb_done = nvme_feat_done;
+	ccb->ccb_cookie = &state;
+
+	rv = nvme_poll(sc, sc->sc_admin_q, ccb, nvme_feat_fill);
+
+	scsi_io_put(&sc->sc_iopool, ccb);
+
+	if (rv != 0)
+		return (1);
+
+	nsqa = (state.cdw0 & 0xffff) + 1;
+	ncqa = (state.cdw0 >> 16) + 1;
+	if (ncqa > nsqa)
+		ncqa = nsqa;
+	if (ncqa <= 1)
+		return (1);
+
+	/* keep one pair back for the hibernate queue */
+	ncqa--;
+
+	return (MIN(nq, ncqa));
+}
+
 void
 nvme_op_cq_done(struct nvme_softc *sc,
     struct nvme_queue *q, struct nvme_ccb *ccb)
@@ -1415,9 +1526,12 @@ nvme_intr(void *xsc)
 {
 	struct nvme_softc *sc = xsc;
 	int rv = 0;
+	u_int i;
 
-	if (nvme_q_complete(sc, sc->sc_q))
-		rv = 1;
+	for (i = 0; i < sc->sc_nq; i++) {
+		if (nvme_q_complete(sc, sc->sc_q[i]))
+			rv = 1;
+	}
 	if (nvme_q_complete(sc, sc->sc_admin_q))
 		rv = 1;
 
@@ -1666,9 +1780,8 @@ nvme_hibernate_io(dev_t dev, daddr_t blkno, vaddr_t addr, size_t size,
 	isqe->nlb = (size / DEV_BSIZE) - 1;
 	isqe->cid = blkno % 0xffff;
 
-	nvme_write4(my->sc, NVME_SQTDBL(NVME_HIB_Q, my->sc->sc_dstrd),
-	    my->sq_tail);
-	nvme_barrier(my->sc, NVME_SQTDBL(NVME_HIB_Q, my->sc->sc_dstrd), 4,
+	nvme_write4(my->sc, my->sc->sc_hib_q->q_sqtdbl, my->sq_tail);
+	nvme_barrier(my->sc, my->sc->sc_hib_q->q_sqtdbl, 4,
 	    BUS_SPACE_BARRIER_WRITE);
 
 	error = 0;
@@ -1700,9 +1813,8 @@ nvme_hibernate_io(dev_t dev, daddr_t blkno, vaddr_t addr, size_t size,
 		my->cqe_phase ^= NVME_CQE_PHASE;
 	}
 
-	nvme_write4(my->sc, NVME_CQHDBL(NVME_HIB_Q, my->sc->sc_dstrd),
-	    my->cq_head);
-	nvme_barrier(my->sc, NVME_CQHDBL(NVME_HIB_Q, my->sc->sc_dstrd), 4,
+	nvme_write4(my->sc, my->sc->sc_hib_q->q_cqhdbl, my->cq_head);
+	nvme_barrier(my->sc, my->sc->sc_hib_q->q_cqhdbl, 4,
 	    BUS_SPACE_BARRIER_WRITE);
 
 	return (error);
@@ -248,6 +248,9 @@ struct nvme_cqe {
 #define NVM_ADMIN_FW_ACTIVATE	0x10 /* Firmware Activate */
 #define NVM_ADMIN_FW_DOWNLOAD	0x11 /* Firmware Image Download */
 
+#define NVM_FEAT_NUMBER_OF_QUEUES \
+				0x07 /* Number of Queues feature */
+
 #define NVM_CMD_FLUSH		0x00 /* Flush */
 #define NVM_CMD_WRITE		0x01 /* Write */
 #define NVM_CMD_READ		0x02 /* Read */
@@ -17,7 +17,7 @@
  */
 
 #define NVME_IO_Q	1
-#define NVME_HIB_Q	2
+#define NVME_MAXQ	8
 #define NVME_MAXPHYS	(128 * 1024)
 
 struct nvme_dmamem {
@@ -117,7 +117,8 @@ struct nvme_softc {
 	struct nvme_namespace	*sc_namespaces;
 
 	struct nvme_queue	*sc_admin_q;
-	struct nvme_queue	*sc_q;
+	struct nvme_queue	*sc_q[NVME_MAXQ];
+	u_int			sc_nq;
 	struct nvme_queue	*sc_hib_q;
 
 	struct mutex		sc_ccb_mtx;
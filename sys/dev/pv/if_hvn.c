@@ -202,7 +202,8 @@ void	hvn_nvs_detach(struct hvn_softc *);
 /* RNDIS */
 int	hvn_rndis_attach(struct hvn_softc *);
 int	hvn_rndis_cmd(struct hvn_softc *, struct rndis_cmd *, int);
-void	hvn_rndis_input(struct hvn_softc *, uint64_t, void *);
+void	hvn_rndis_input(struct hvn_softc *, uint64_t, void *,
+	    struct mbuf_list *);
 void	hvn_rxeof(struct hvn_softc *, caddr_t, uint32_t, struct mbuf_list *);
 void	hvn_rndis_complete(struct hvn_softc *, caddr_t, uint32_t);
 int	hvn_rndis_output(struct hvn_softc *, struct hvn_tx_desc *);
@@ -973,6 +974,7 @@ hvn_nvs_intr(void *arg)
 {
 	struct hvn_softc *sc = arg;
 	struct ifnet *ifp = &sc->sc_ac.ac_if;
+	struct mbuf_list ml = MBUF_LIST_INITIALIZER();
 	struct vmbus_chanpkt_hdr *cph;
 	struct hvn_nvs_hdr *nvs;
 	uint64_t rid;
@@ -1013,7 +1015,7 @@ hvn_nvs_intr(void *arg)
 		} else if (cph->cph_type == VMBUS_CHANPKT_TYPE_RXBUF) {
 			switch (nvs->nvs_type) {
 			case HVN_NVS_TYPE_RNDIS:
-				hvn_rndis_input(sc, cph->cph_tid, cph);
+				hvn_rndis_input(sc, cph->cph_tid, cph, &ml);
 				break;
 			default:
 				printf("%s: unhandled NVSP packet type %u "
@@ -1025,6 +1027,17 @@ hvn_nvs_intr(void *arg)
 			    sc->sc_dev.dv_xname, cph->cph_type);
 	}
 
+	/*
+	 * Packets harvested from the whole ring are handed to the
+	 * stack in one go once the ring is empty.
+	 */
+	if (!ml_empty(&ml)) {
+		if (ifp->if_flags & IFF_RUNNING)
+			if_input(ifp, &ml);
+		else
+			ml_purge(&ml);
+	}
+
 	if (ifq_is_oactive(&ifp->if_snd))
 		ifq_restart(&ifp->if_snd);
 }
@@ -1423,10 +1436,9 @@ hvn_rndis_cmd(struct hvn_softc *sc, struct rndis_cmd *rc, int timo)
 }
 
 void
-hvn_rndis_input(struct hvn_softc *sc, uint64_t tid, void *arg)
+hvn_rndis_input(struct hvn_softc *sc, uint64_t tid, void *arg,
+    struct mbuf_list *ml)
 {
-	struct ifnet *ifp = &sc->sc_ac.ac_if;
-	struct mbuf_list ml = MBUF_LIST_INITIALIZER();
 	struct vmbus_chanpkt_prplist *cp = arg;
 	uint32_t off, len, type;
 	int i;
@@ -1447,7 +1459,7 @@ hvn_rndis_input(struct hvn_softc *sc, uint64_t tid, void *arg)
 		/* data message */
 		case REMOTE_NDIS_PACKET_MSG:
 			hvn_rxeof(sc, (caddr_t)sc->sc_rx_ring +
-			    off, len, &ml);
+			    off, len, ml);
 			break;
 		/* completion messages */
 		case REMOTE_NDIS_INITIALIZE_CMPLT:
@@ -1469,11 +1481,6 @@ hvn_rndis_input(struct hvn_softc *sc, uint64_t tid, void *arg)
 		}
 	}
 	hvn_nvs_ack(sc, tid);
-
-	if (ifp->if_flags & IFF_RUNNING)
-		if_input(ifp, &ml);
-	else
-		ml_purge(&ml);
 }
 
 static inline struct mbuf *
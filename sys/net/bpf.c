@@ -794,6 +794,7 @@ bpfioctl(dev_t dev, u_long cmd, caddr_t addr, int flag, struct proc *p)
 		case BIOCGETIF:
 		case BIOCGRTIMEOUT:
 		case BIOCGWTIMEOUT:
+		case BIOCGWATERMARK:
 		case BIOCGSTATS:
 		case BIOCVERSION:
 		case BIOCGRSIG:
@@ -1025,6 +1026,27 @@ bpfioctl(dev_t dev, u_long cmd, caddr_t addr, int flag, struct proc *p)
 		error = bpf_set_wtout(d, INFSLP);
 		break;
 
+	/*
+	 * Set wakeup watermark.
+	 */
+	case BIOCSWATERMARK:
+		mtx_enter(&d->bd_mtx);
+		if (*(u_int *)addr > d->bd_bufsize)
+			d->bd_wmark = d->bd_bufsize;
+		else
+			d->bd_wmark = *(u_int *)addr;
+		mtx_leave(&d->bd_mtx);
+		break;
+
+	/*
+	 * Get wakeup watermark.
+	 */
+	case BIOCGWATERMARK:
+		mtx_enter(&d->bd_mtx);
+		*(u_int *)addr = d->bd_wmark;
+		mtx_leave(&d->bd_mtx);
+		break;
+
 	case BIOCVERSION:
 		{
 			struct bpf_version *bv = (struct bpf_version *)addr;
@@ -1626,7 +1648,16 @@ bpf_catchpacket(struct bpf_d *d, u_char *pkt, size_t pktlen, size_t snaplen,
 	bpf_mcopy(pkt, (u_char *)bh + hdrlen, bh->bh_caplen);
 	d->bd_slen = curlen + totlen;
 
-	switch (d->bd_wtout) {
+	if (d->bd_wmark != 0 && d->bd_slen >= d->bd_wmark) {
+		/*
+		 * Enough data has accumulated to satisfy the wakeup
+		 * watermark; wake the reader without waiting for the
+		 * buffer to fill or the wait timeout to fire.
+		 */
+		if (d->bd_state != BPF_S_DONE)
+			d->bd_state = BPF_S_DONE;
+		do_wakeup = 1;
+	} else switch (d->bd_wtout) {
 	case 0:
 		/*
 		 * Immediate mode is set.  A packet arrived so any
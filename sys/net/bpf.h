@@ -122,6 +122,8 @@ struct bpf_version {
 #define BIOCSWTIMEOUT	_IOW('B',126, struct timeval)
 #define BIOCGWTIMEOUT	_IOR('B',126, struct timeval)
 #define BIOCDWTIMEOUT	_IO('B',126)
+#define BIOCSWATERMARK	_IOW('B',127, u_int)
+#define BIOCGWATERMARK	_IOR('B',127, u_int)
 
 /*
  * Direction filters for BIOCSDIRFILT/BIOCGDIRFILT
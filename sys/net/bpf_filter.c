@@ -142,8 +142,9 @@ u_int
 _bpf_filter(const struct bpf_insn *pc, const struct bpf_ops *ops,
     const void *pkt, u_int wirelen)
 {
+	const struct bpf_mem *bm = NULL;
 	u_int32_t A = 0, X = 0;
-	u_int32_t k;
+	u_int32_t k, v;
 	int32_t mem[BPF_MEMWORDS];
 	int err;
 
@@ -154,6 +155,15 @@ _bpf_filter(const struct bpf_insn *pc, const struct bpf_ops *ops,
 		return (u_int)-1;
 	}
 
+	/*
+	 * Loads from a contiguous buffer are inlined below instead of
+	 * bouncing through the ops vector; the indirect calls and the
+	 * error out-parameter cost more than the loads themselves on
+	 * filter-heavy captures.
+	 */
+	if (ops == &bpf_mem_ops)
+		bm = pkt;
+
 	memset(mem, 0, sizeof(mem));
 
 	--pc;
@@ -174,19 +184,44 @@ _bpf_filter(const struct bpf_insn *pc, const struct bpf_ops *ops,
 			return (u_int)A;
 
 		case BPF_LD|BPF_W|BPF_ABS:
-			A = ops->ldw(pkt, pc->k, &err);
+			k = pc->k;
+			if (bm != NULL) {
+				if (k + sizeof(v) > bm->len)
+					return 0;
+				memcpy(&v, bm->pkt + k, sizeof(v));
+				A = ntohl(v);
+				continue;
+			}
+			A = ops->ldw(pkt, k, &err);
 			if (err != 0)
 				return 0;
 			continue;
 
 		case BPF_LD|BPF_H|BPF_ABS:
-			A = ops->ldh(pkt, pc->k, &err);
+			k = pc->k;
+			if (bm != NULL) {
+				u_int16_t h;
+
+				if (k + sizeof(h) > bm->len)
+					return 0;
+				memcpy(&h, bm->pkt + k, sizeof(h));
+				A = ntohs(h);
+				continue;
+			}
+			A = ops->ldh(pkt, k, &err);
 			if (err != 0)
 				return 0;
 			continue;
 
 		case BPF_LD|BPF_B|BPF_ABS:
-			A = ops->ldb(pkt, pc->k, &err);
+			k = pc->k;
+			if (bm != NULL) {
+				if (k >= bm->len)
+					return 0;
+				A = bm->pkt[k];
+				continue;
+			}
+			A = ops->ldb(pkt, k, &err);
 			if (err != 0)
 				return 0;
 			continue;
@@ -205,6 +240,13 @@ _bpf_filter(const struct bpf_insn *pc, const struct bpf_ops *ops,
 
 		case BPF_LD|BPF_W|BPF_IND:
 			k = X + pc->k;
+			if (bm != NULL) {
+				if (k + sizeof(v) > bm->len)
+					return 0;
+				memcpy(&v, bm->pkt + k, sizeof(v));
+				A = ntohl(v);
+				continue;
+			}
 			A = ops->ldw(pkt, k, &err);
 			if (err != 0)
 				return 0;
@@ -212,6 +254,15 @@ _bpf_filter(const struct bpf_insn *pc, const struct bpf_ops *ops,
 
 		case BPF_LD|BPF_H|BPF_IND:
 			k = X + pc->k;
+			if (bm != NULL) {
+				u_int16_t h;
+
+				if (k + sizeof(h) > bm->len)
+					return 0;
+				memcpy(&h, bm->pkt + k, sizeof(h));
+				A = ntohs(h);
+				continue;
+			}
 			A = ops->ldh(pkt, k, &err);
 			if (err != 0)
 				return 0;
@@ -219,13 +270,26 @@ _bpf_filter(const struct bpf_insn *pc, const struct bpf_ops *ops,
 
 		case BPF_LD|BPF_B|BPF_IND:
 			k = X + pc->k;
+			if (bm != NULL) {
+				if (k >= bm->len)
+					return 0;
+				A = bm->pkt[k];
+				continue;
+			}
 			A = ops->ldb(pkt, k, &err);
 			if (err != 0)
 				return 0;
 			continue;
 
 		case BPF_LDX|BPF_MSH|BPF_B:
-			X = ops->ldb(pkt, pc->k, &err);
+			k = pc->k;
+			if (bm != NULL) {
+				if (k >= bm->len)
+					return 0;
+				X = (bm->pkt[k] & 0xf) << 2;
+				continue;
+			}
+			X = ops->ldb(pkt, k, &err);
 			if (err != 0)
 				return 0;
 			X &= 0xf;
@@ -80,6 +80,7 @@ struct bpf_d {
 	struct bpf_if  *bd_bif;		/* interface descriptor */
 	uint64_t	bd_rtout;	/* [m] Read timeout in nanoseconds */
 	uint64_t	bd_wtout;	/* [m] Wait time in nanoseconds */
+	u_int		bd_wmark;	/* [m] Wakeup watermark in bytes */
 	u_long		bd_nreaders;	/* [m] # threads asleep in bpfread() */
 	struct bpf_program_smr
 		       *bd_rfilter;	/* read filter code */
@@ -824,6 +824,9 @@ fqcodel_pf_qstats(struct pf_queuespec *qs, void *ubuf, int *nbytes)
 	stats.qlength = ifq_len(&ifp->if_snd);
 	stats.qlimit = fqc->qlimit;
 
+	stats.target = fqc->cparams.target / 1000;
+	stats.interval = fqc->cparams.interval / 1000;
+
 	stats.flows = 0;
 	stats.delaysum = stats.delaysumsq = 0;
 
@@ -35,8 +35,8 @@ struct fqcodel_stats {
 	uint32_t		flows;
 	uint32_t		_unused;   /* padding */
 
-	uint32_t		target;
-	uint32_t		interval;
+	uint32_t		target;	   /* codel target delay, us */
+	uint32_t		interval;  /* codel interval, us */
 
 	/* the values below are used to calculate standard deviation */
 	uint64_t		delaysum;  /* sum of delays, us */
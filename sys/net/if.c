@@ -990,6 +990,15 @@ if_input_process(struct ifnet *ifp, struct mbuf_list *ml)
 	if (!ISSET(ifp->if_xflags, IFXF_CLONED))
 		enqueue_randomness(ml_len(ml) ^ (uintptr_t)MBUF_LIST_FIRST(ml));
 
+	/*
+	 * If LRO is enabled but the hardware cannot coalesce, do it in
+	 * software before the packets are passed up the stack.
+	 */
+	if (ISSET(ifp->if_xflags, IFXF_LRO) &&
+	    !ISSET(ifp->if_capabilities, IFCAP_LRO) &&
+	    ifp->if_type == IFT_ETHER)
+		tcp_softlro(ml);
+
 	/*
 	 * We grab the shared netlock for packet processing in the softnet
 	 * threads.  Packets can regrab the exclusive lock via queues.
@@ -3257,7 +3266,9 @@ ifsetlro(struct ifnet *ifp, int on)
 		}
 	}
 
-	if (!ISSET(ifp->if_capabilities, IFCAP_LRO)) {
+	/* without hardware support coalescing is done in software */
+	if (!ISSET(ifp->if_capabilities, IFCAP_LRO) &&
+	    ifp->if_type != IFT_ETHER) {
 		error = ENOTSUP;
 		goto out;
 	}
@@ -17,6 +17,7 @@
  */
 
 #include "bpfilter.h"
+#include "kstat.h"
 
 #include <sys/param.h>
 #include <sys/systm.h>
@@ -27,6 +28,11 @@
 #include <sys/timeout.h>
 #include <sys/pool.h>
 #include <sys/tree.h>
+#include <sys/percpu.h>
+
+#if NKSTAT > 0
+#include <sys/kstat.h>
+#endif
 
 #include <net/if.h>
 #include <net/if_var.h>
@@ -84,6 +90,66 @@ eb_port_sa(struct etherbridge *eb, struct sockaddr_storage *ss, void *port)
 	(*eb->eb_ops->eb_op_port_sa)(eb->eb_cookie, ss, port);
 }
 
+#if NKSTAT > 0
+struct etherbridge_kstat_data {
+	struct kstat_kv		 ekd_hits;
+	struct kstat_kv		 ekd_misses;
+	struct kstat_kv		 ekd_expired;
+	struct kstat_kv		 ekd_learns;
+	struct kstat_kv		 ekd_moves;
+};
+
+static const struct etherbridge_kstat_data etherbridge_kstat_tpl = {
+	KSTAT_KV_UNIT_INITIALIZER("hits",
+	    KSTAT_KV_T_COUNTER64, KSTAT_KV_U_PACKETS),
+	KSTAT_KV_UNIT_INITIALIZER("misses",
+	    KSTAT_KV_T_COUNTER64, KSTAT_KV_U_PACKETS),
+	KSTAT_KV_UNIT_INITIALIZER("expired",
+	    KSTAT_KV_T_COUNTER64, KSTAT_KV_U_PACKETS),
+	KSTAT_KV_UNIT_INITIALIZER("learns",
+	    KSTAT_KV_T_COUNTER64, KSTAT_KV_U_PACKETS),
+	KSTAT_KV_UNIT_INITIALIZER("moves",
+	    KSTAT_KV_T_COUNTER64, KSTAT_KV_U_PACKETS),
+};
+
+static int
+etherbridge_kstat_copy(struct kstat *ks, void *dst)
+{
+	struct etherbridge *eb = ks->ks_softc;
+	struct etherbridge_kstat_data *kd = dst;
+	uint64_t counters[ebc_ncounters];
+
+	counters_read(eb->eb_counters, counters, nitems(counters), NULL);
+
+	*kd = etherbridge_kstat_tpl;
+	kstat_kv_u64(&kd->ekd_hits) = counters[ebc_hit];
+	kstat_kv_u64(&kd->ekd_misses) = counters[ebc_miss];
+	kstat_kv_u64(&kd->ekd_expired) = counters[ebc_expired];
+	kstat_kv_u64(&kd->ekd_learns) = counters[ebc_learn];
+	kstat_kv_u64(&kd->ekd_moves) = counters[ebc_move];
+
+	return (0);
+}
+
+static void
+etherbridge_kstat_attach(struct etherbridge *eb)
+{
+	struct kstat *ks;
+
+	ks = kstat_create(eb->eb_name, 0, "etherbridge", 0,
+	    KSTAT_T_KV, 0);
+	if (ks == NULL)
+		return;
+
+	ks->ks_softc = eb;
+	ks->ks_datalen = sizeof(etherbridge_kstat_tpl);
+	ks->ks_copy = etherbridge_kstat_copy;
+	kstat_install(ks);
+
+	eb->eb_kstat = ks;
+}
+#endif /* NKSTAT > 0 */
+
 int
 etherbridge_init(struct etherbridge *eb, const char *name,
     const struct etherbridge_ops *ops, void *cookie)
@@ -117,6 +183,12 @@ etherbridge_init(struct etherbridge *eb, const char *name,
 		SMR_TAILQ_INIT(ebl);
 	}
 
+	eb->eb_counters = counters_alloc(ebc_ncounters);
+
+#if NKSTAT > 0
+	etherbridge_kstat_attach(eb);
+#endif
+
 	return (0);
 }
 
@@ -145,6 +217,14 @@ etherbridge_destroy(struct etherbridge *eb)
 
 	timeout_del_barrier(&eb->eb_tmo_age);
 
+#if NKSTAT > 0
+	if (eb->eb_kstat != NULL) {
+		kstat_destroy(eb->eb_kstat);
+		eb->eb_kstat = NULL;
+	}
+#endif
+	counters_free(eb->eb_counters, ebc_ncounters);
+
 	free(eb->eb_table, M_DEVBUF,
 	    ETHERBRIDGE_TABLE_SIZE * sizeof(*eb->eb_table));
 
@@ -266,13 +346,17 @@ etherbridge_resolve(struct etherbridge *eb, uint64_t eba)
 	if (ebe != NULL) {
 		if (ebe->ebe_type == EBE_DYNAMIC) {
 			int diff = getuptime() - ebe->ebe_age;
-			if (diff > eb->eb_max_age)
+			if (diff > eb->eb_max_age) {
+				counters_inc(eb->eb_counters, ebc_expired);
 				return (NULL);
+			}
 		}
 
+		counters_inc(eb->eb_counters, ebc_hit);
 		return (ebe->ebe_port);
 	}
 
+	counters_inc(eb->eb_counters, ebc_miss);
 	return (NULL);
 }
 
@@ -359,6 +443,7 @@ etherbridge_map(struct etherbridge *eb, void *port, uint64_t eba)
 			/* great success */
 			eb->eb_num = num;
 			nebe = NULL; /* give ref to table */
+			counters_inc(eb->eb_counters, ebc_learn);
 		}
 	} else if (oebe->ebe_type == EBE_DYNAMIC) {
 		/* do the update */
@@ -368,6 +453,7 @@ etherbridge_map(struct etherbridge *eb, void *port, uint64_t eba)
 		ebt_replace(eb, oebe, nebe);
 
 		nebe = NULL; /* give ref to table */
+		counters_inc(eb->eb_counters, ebc_move);
 	} else {
 		/*
 		 * oebe is not a dynamic entry, so don't replace it.
@@ -58,6 +58,17 @@ SMR_TAILQ_HEAD(eb_list, eb_entry);
 RBT_HEAD(eb_tree, eb_entry);
 TAILQ_HEAD(eb_queue, eb_entry);
 
+/* per-CPU counters for the forwarding path */
+enum eb_counter {
+	ebc_hit,		/* resolve found a live entry */
+	ebc_miss,		/* resolve found nothing */
+	ebc_expired,		/* resolve found a stale dynamic entry */
+	ebc_learn,		/* map inserted a new entry */
+	ebc_move,		/* map replaced an entry on another port */
+
+	ebc_ncounters
+};
+
 struct etherbridge {
 	const char			*eb_name;
 	const struct etherbridge_ops	*eb_ops;
@@ -72,6 +83,8 @@ struct etherbridge {
 	struct eb_list			*eb_table;
 	struct eb_tree			 eb_tree;
 
+	struct cpumem			*eb_counters;
+	struct kstat			*eb_kstat;
 };
 
 int	 etherbridge_init(struct etherbridge *, const char *,
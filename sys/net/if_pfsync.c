@@ -191,7 +191,7 @@ struct pfsync_slice {
 	struct kstat		*s_kstat;
 } __aligned(CACHELINESIZE);
 
-#define PFSYNC_SLICE_BITS	 1
+#define PFSYNC_SLICE_BITS	 3
 #define PFSYNC_NSLICES		 (1 << PFSYNC_SLICE_BITS)
 
 struct pfsync_softc {
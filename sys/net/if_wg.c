@@ -260,8 +260,8 @@ struct wg_softc {
 	struct task		 sc_handshake;
 	struct mbuf_queue	 sc_handshake_queue;
 
-	struct task		 sc_encap;
-	struct task		 sc_decap;
+	struct task		*sc_encap_tasks;	/* [I] one per CPU */
+	struct task		*sc_decap_tasks;	/* [I] one per CPU */
 	struct wg_ring		 sc_encap_ring;
 	struct wg_ring		 sc_decap_ring;
 };
@@ -335,6 +335,7 @@ void	wg_handshake_worker(void *);
 
 void	wg_encap(struct wg_softc *, struct mbuf *);
 void	wg_decap(struct wg_softc *, struct mbuf *);
+void	wg_crypt_dispatch(struct task *);
 void	wg_encap_worker(void *);
 void	wg_decap_worker(void *);
 void	wg_deliver_out(void *);
@@ -1315,7 +1316,7 @@ wg_send_keepalive(void *_peer)
 send:
 	if (noise_remote_ready(&peer->p_remote) == 0) {
 		wg_queue_out(sc, peer);
-		task_add(wg_crypt_taskq, &sc->sc_encap);
+		wg_crypt_dispatch(sc->sc_encap_tasks);
 	} else {
 		wg_timers_event_want_initiation(&peer->p_timers);
 	}
@@ -1695,6 +1696,21 @@ error:
 	task_add(net_tq(sc->sc_if.if_index), &peer->p_deliver_in);
 }
 
+/*
+ * The crypt taskq has one thread per CPU, but a single task only ever
+ * runs on one of them at a time.  Schedule one task per CPU so every
+ * thread helps drain the parallel ring; workers that find the ring
+ * empty simply return.  The serial queues keep per-peer ordering.
+ */
+void
+wg_crypt_dispatch(struct task *tasks)
+{
+	int i;
+
+	for (i = 0; i < ncpus; i++)
+		task_add(wg_crypt_taskq, &tasks[i]);
+}
+
 void
 wg_encap_worker(void *_sc)
 {
@@ -2073,7 +2089,7 @@ wg_input(void *_sc, struct mbuf *m, struct ip *ip, struct ip6_hdr *ip6,
 			if (wg_queue_in(sc, t->t_peer, m) != 0)
 				counters_inc(sc->sc_if.if_counters,
 				    ifc_iqdrops);
-			task_add(wg_crypt_taskq, &sc->sc_decap);
+			wg_crypt_dispatch(sc->sc_decap_tasks);
 		} else {
 			counters_inc(sc->sc_if.if_counters, ifc_ierrors);
 			m_freem(m);
@@ -2120,7 +2136,7 @@ wg_qstart(struct ifqueue *ifq)
 			wg_timers_event_want_initiation(&peer->p_timers);
 		peer->p_start_onlist = 0;
 	}
-	task_add(wg_crypt_taskq, &sc->sc_encap);
+	wg_crypt_dispatch(sc->sc_encap_tasks);
 }
 
 int
@@ -2596,6 +2612,7 @@ wg_clone_create(struct if_clone *ifc, int unit)
 	struct ifnet		*ifp;
 	struct wg_softc		*sc;
 	struct noise_upcall	 local_upcall;
+	int			 i;
 
 	KERNEL_ASSERT_LOCKED();
 
@@ -2665,8 +2682,16 @@ wg_clone_create(struct if_clone *ifc, int unit)
 	task_set(&sc->sc_handshake, wg_handshake_worker, sc);
 	mq_init(&sc->sc_handshake_queue, MAX_QUEUED_HANDSHAKES, IPL_NET);
 
-	task_set(&sc->sc_encap, wg_encap_worker, sc);
-	task_set(&sc->sc_decap, wg_decap_worker, sc);
+	sc->sc_encap_tasks = mallocarray(ncpus, sizeof(struct task),
+	    M_DEVBUF, M_NOWAIT|M_ZERO);
+	sc->sc_decap_tasks = mallocarray(ncpus, sizeof(struct task),
+	    M_DEVBUF, M_NOWAIT|M_ZERO);
+	if (sc->sc_encap_tasks == NULL || sc->sc_decap_tasks == NULL)
+		goto ret_06;
+	for (i = 0; i < ncpus; i++) {
+		task_set(&sc->sc_encap_tasks[i], wg_encap_worker, sc);
+		task_set(&sc->sc_decap_tasks[i], wg_decap_worker, sc);
+	}
 
 	bzero(&sc->sc_encap_ring, sizeof(sc->sc_encap_ring));
 	mtx_init(&sc->sc_encap_ring.r_mtx, IPL_NET);
@@ -2702,6 +2727,10 @@ wg_clone_create(struct if_clone *ifc, int unit)
 	DPRINTF(sc, "Interface created\n");
 
 	return 0;
+ret_06:
+	free(sc->sc_encap_tasks, M_DEVBUF, ncpus * sizeof(struct task));
+	free(sc->sc_decap_tasks, M_DEVBUF, ncpus * sizeof(struct task));
+	hashfree(sc->sc_index, HASHTABLE_INDEX_SIZE, M_DEVBUF);
 ret_05:
 	hashfree(sc->sc_peer, HASHTABLE_PEER_SIZE, M_DEVBUF);
 ret_04:
@@ -2744,6 +2773,8 @@ wg_clone_destroy(struct ifnet *ifp)
 
 	DPRINTF(sc, "Destroyed interface\n");
 
+	free(sc->sc_encap_tasks, M_DEVBUF, ncpus * sizeof(struct task));
+	free(sc->sc_decap_tasks, M_DEVBUF, ncpus * sizeof(struct task));
 	hashfree(sc->sc_index, HASHTABLE_INDEX_SIZE, M_DEVBUF);
 	hashfree(sc->sc_peer, HASHTABLE_PEER_SIZE, M_DEVBUF);
 #ifdef INET6
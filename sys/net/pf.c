@@ -233,6 +233,8 @@ int			 pf_compare_state_keys(struct pf_state_key *,
 u_int16_t		 pf_pkt_hash(sa_family_t, uint8_t,
 			     const struct pf_addr *, const struct pf_addr *,
 			     uint16_t, uint16_t);
+struct pf_state_key	*pf_skcache_lookup(struct pf_state_key_cmp *);
+void			 pf_skcache_store(struct pf_state_key *);
 int			 pf_find_state(struct pf_pdesc *,
 			    struct pf_state_key_cmp *, struct pf_state **);
 int			 pf_src_connlimit(struct pf_state **);
@@ -1125,6 +1127,48 @@ pf_compare_state_keys(struct pf_state_key *a, struct pf_state_key *b,
 	}
 }
 
+/*
+ * Per-CPU cache of the most recently found state key.  Established
+ * connections tend to deliver bursts of packets for the same flow to
+ * the same CPU, so a single cached key avoids most of the state tree
+ * walks.  The cache holds its own reference; entries whose key has
+ * been detached from the tree fail pf_state_key_isvalid() and are
+ * dropped lazily on the next probe.
+ */
+struct pf_state_key *
+pf_skcache_lookup(struct pf_state_key_cmp *key)
+{
+	struct pf_state_key	**skcp, *sk;
+
+	skcp = (struct pf_state_key **)cpumem_enter(pf_skcache);
+	sk = *skcp;
+	if (sk != NULL && !pf_state_key_isvalid(sk)) {
+		*skcp = NULL;
+		cpumem_leave(pf_skcache, skcp);
+		pf_state_key_unref(sk);
+		return (NULL);
+	}
+	if (sk != NULL &&
+	    pf_state_compare_key((struct pf_state_key *)key, sk) != 0)
+		sk = NULL;
+	cpumem_leave(pf_skcache, skcp);
+
+	return (sk);
+}
+
+void
+pf_skcache_store(struct pf_state_key *sk)
+{
+	struct pf_state_key	**skcp, *osk;
+
+	skcp = (struct pf_state_key **)cpumem_enter(pf_skcache);
+	osk = *skcp;
+	*skcp = pf_state_key_ref(sk);
+	cpumem_leave(pf_skcache, skcp);
+	if (osk != NULL)
+		pf_state_key_unref(osk);
+}
+
 int
 pf_find_state(struct pf_pdesc *pd, struct pf_state_key_cmp *key,
     struct pf_state **stp)
@@ -1182,9 +1226,12 @@ pf_find_state(struct pf_pdesc *pd, struct pf_state_key_cmp *key,
 	}
 
 	if (sk == NULL) {
-		if ((sk = RBT_FIND(pf_state_tree, &pf_statetbl,
-		    (struct pf_state_key *)key)) == NULL)
-			return (PF_DROP);
+		if ((sk = pf_skcache_lookup(key)) == NULL) {
+			if ((sk = RBT_FIND(pf_state_tree, &pf_statetbl,
+			    (struct pf_state_key *)key)) == NULL)
+				return (PF_DROP);
+			pf_skcache_store(sk);
+		}
 		if (pd->dir == PF_OUT && pkt_sk &&
 		    pf_compare_state_keys(pkt_sk, sk, pd->kif, pd->dir) == 0)
 			pf_state_key_link_reverse(sk, pkt_sk);
@@ -2248,6 +2295,58 @@ pf_calc_skip_steps(struct pf_rulequeue *rules)
 		PF_SET_SKIP_STEPS(i);
 }
 
+int
+pf_proto_start_idx(u_int8_t proto)
+{
+	switch (proto) {
+	case IPPROTO_TCP:
+		return (PF_START_TCP);
+	case IPPROTO_UDP:
+		return (PF_START_UDP);
+	case IPPROTO_ICMP:
+		return (PF_START_ICMP);
+	case IPPROTO_ICMPV6:
+		return (PF_START_ICMP6);
+	default:
+		return (PF_START_OTHER);
+	}
+}
+
+/*
+ * Precompute, for each protocol class, the first rule in the active
+ * queue that could possibly match a packet of that protocol.  Rules
+ * ahead of that point carry a different specific protocol and can
+ * never match, so rule evaluation may start there without changing
+ * first-match semantics.  Like the skip steps this is recomputed
+ * whenever the active queue changes, i.e. at ruleset commit time.
+ */
+void
+pf_calc_proto_start(struct pf_ruleset *ruleset)
+{
+	struct pf_rule	*r;
+	int		 i, unset;
+
+	for (i = 0; i < PF_START_COUNT; ++i)
+		ruleset->proto_start[i] = NULL;
+
+	unset = PF_START_COUNT;
+	TAILQ_FOREACH(r, ruleset->rules.active.ptr, entries) {
+		if (r->proto == 0) {
+			/* wildcard rule covers every remaining class */
+			for (i = 0; i < PF_START_COUNT; ++i)
+				if (ruleset->proto_start[i] == NULL)
+					ruleset->proto_start[i] = r;
+			break;
+		}
+		i = pf_proto_start_idx(r->proto);
+		if (ruleset->proto_start[i] == NULL) {
+			ruleset->proto_start[i] = r;
+			if (--unset == 0)
+				break;
+		}
+	}
+}
+
 int
 pf_addr_wrap_neq(struct pf_addr_wrap *aw1, struct pf_addr_wrap *aw2)
 {
@@ -4093,7 +4192,7 @@ pf_match_rule(struct pf_test_ctx *ctx, struct pf_ruleset *ruleset)
 
 	pf_anchor_stack_init();
 enter_ruleset:
-	r = TAILQ_FIRST(ruleset->rules.active.ptr);
+	r = ruleset->proto_start[pf_proto_start_idx(ctx->pd->proto)];
 	while (r != NULL) {
 		PF_TEST_ATTRIB(r->rule_flag & PFRULE_EXPIRED,
 		    TAILQ_NEXT(r, entries));
@@ -8029,6 +8128,31 @@ done:
 	return (action);
 }
 
+/*
+ * Batched variant of pf_test() for drivers and input paths that
+ * dequeue bursts of packets.  Filtered packets stay on the list,
+ * dropped ones are freed in place.  Running the whole burst back to
+ * back keeps the ruleset, state tree and per-CPU caches hot instead
+ * of paying the warm-up cost once per packet.
+ */
+void
+pf_test_pkts(sa_family_t af, int fwdir, struct ifnet *ifp,
+    struct mbuf_list *ml)
+{
+	struct mbuf_list	 fml = MBUF_LIST_INITIALIZER();
+	struct mbuf		*m;
+
+	while ((m = ml_dequeue(ml)) != NULL) {
+		if (pf_test(af, fwdir, ifp, &m) != PF_PASS) {
+			m_freem(m);
+			continue;
+		}
+		if (m != NULL)
+			ml_enqueue(&fml, m);
+	}
+	*ml = fml;
+}
+
 int
 pf_ouraddr(struct mbuf *m)
 {
@@ -166,6 +166,7 @@ struct rwlock		 pf_state_lock = RWLOCK_INITIALIZER("pf_state_lock");
 struct rwlock		 pfioctl_rw = RWLOCK_INITIALIZER("pfioctl_rw");
 
 struct cpumem *pf_anchor_stack;
+struct cpumem *pf_skcache;
 
 #if (PF_QNAME_SIZE != PF_TAG_NAME_SIZE)
 #error PF_QNAME_SIZE must be equal to PF_TAG_NAME_SIZE
@@ -291,6 +292,9 @@ pfattach(int num)
 	    M_WAITOK|M_ZERO);
 	CPUMEM_FOREACH(sf, &cmi, pf_anchor_stack)
 		sf[PF_ANCHOR_STACK_MAX].sf_stack_top = &sf[0];
+
+	pf_skcache = cpumem_malloc(sizeof(struct pf_state_key *),
+	    M_WAITOK|M_ZERO);
 }
 
 int
@@ -882,6 +886,7 @@ pf_commit_rules(u_int32_t version, char *anchor)
 
 	rs->rules.active.version = rs->rules.inactive.version;
 	pf_calc_skip_steps(rs->rules.active.ptr);
+	pf_calc_proto_start(rs);
 
 
 	/* Purge the old rule list. */
@@ -1754,6 +1759,7 @@ pfioctl(dev_t dev, u_long cmd, caddr_t addr, int flags, struct proc *p)
 		ruleset->rules.active.version++;
 
 		pf_calc_skip_steps(ruleset->rules.active.ptr);
+		pf_calc_proto_start(ruleset);
 		pf_remove_if_empty_ruleset(ruleset);
 
 		PF_UNLOCK();
@@ -37,6 +37,7 @@
 #include <sys/pool.h>
 #include <sys/syslog.h>
 #include <sys/proc.h>
+#include <sys/percpu.h>
 
 #include <net/if.h>
 
@@ -146,6 +147,24 @@ struct pool		 pfr_kcounters_pl;
 union sockaddr_union	 pfr_mask;
 struct pf_addr		 pfr_ffaddr;
 
+/*
+ * Per-CPU cache of the last pfr_match_addr() result.  Table lookups
+ * for an established flow repeat the same address many times in a
+ * row, so remembering one (table, address) -> match result per CPU
+ * saves the radix tree descent for the common case.  The cache stores
+ * no kentry pointer, only the boolean result, and is invalidated by
+ * bumping pfr_gen whenever table contents change.
+ */
+struct pfr_mcache {
+	struct pfr_ktable	*mc_kt;
+	struct pf_addr		 mc_addr;
+	u_long			 mc_gen;
+	sa_family_t		 mc_af;
+	int			 mc_match;
+};
+struct cpumem		*pfr_mcache;
+u_long			 pfr_gen;
+
 int			 pfr_gcd(int, int);
 void			 pfr_copyout_addr(struct pfr_addr *,
 			    struct pfr_kentry *ke);
@@ -241,6 +260,9 @@ pfr_initialize(void)
 	    0, IPL_SOFTNET, 0, "pfrkcounters", NULL);
 
 	memset(&pfr_ffaddr, 0xff, sizeof(pfr_ffaddr));
+
+	pfr_mcache = cpumem_malloc(sizeof(struct pfr_mcache),
+	    M_WAITOK|M_ZERO);
 }
 
 int
@@ -1201,6 +1223,8 @@ pfr_clstats_kentries(struct pfr_kentryworkq *workq, time_t tzero, int negchange)
 {
 	struct pfr_kentry	*p;
 
+	if (negchange)
+		pfr_gen++;
 	SLIST_FOREACH(p, workq, pfrke_workq) {
 		if (negchange)
 			p->pfrke_flags ^= PFRKE_FLAG_NOT;
@@ -1289,6 +1313,9 @@ pfr_route_kentry(struct pfr_ktable *kt, struct pfr_kentry *ke)
 	} else
 		rn = rn_addroute(&ke->pfrke_sa, NULL, head, ke->pfrke_node, 0);
 
+	if (rn != NULL)
+		pfr_gen++;
+
 	return (rn == NULL ? -1 : 0);
 }
 
@@ -1322,6 +1349,7 @@ pfr_unroute_kentry(struct pfr_ktable *kt, struct pfr_kentry *ke)
 		DPFPRINTF(LOG_ERR, "pfr_unroute_kentry: delete failed.\n");
 		return (-1);
 	}
+	pfr_gen++;
 	return (0);
 }
 
@@ -2117,6 +2145,7 @@ pfr_commit_ktable(struct pfr_ktable *kt, time_t tzero)
 		    shadow->pfrkt_ip6);
 		SWAP(int, kt->pfrkt_cnt, shadow->pfrkt_cnt);
 		pfr_clstats_ktable(kt, tzero, 1);
+		pfr_gen++;
 	}
 	nflags = ((shadow->pfrkt_flags & PFR_TFLAG_USRMASK) |
 	    (kt->pfrkt_flags & PFR_TFLAG_SETMASK) | PFR_TFLAG_ACTIVE)
@@ -2366,6 +2395,7 @@ pfr_destroy_ktable(struct pfr_ktable *kt, int flushaddr)
 {
 	struct pfr_kentryworkq	 addrq;
 
+	pfr_gen++;
 	if (flushaddr) {
 		pfr_enqueue_addrs(kt, &addrq, NULL, 0);
 		pfr_clean_node_mask(kt, &addrq);
@@ -2405,9 +2435,24 @@ pfr_lookup_table(struct pfr_table *tbl)
 int
 pfr_match_addr(struct pfr_ktable *kt, struct pf_addr *a, sa_family_t af)
 {
+	struct pfr_mcache	*mc;
 	struct pfr_kentry	*ke = NULL;
+	u_long			 gen = pfr_gen;
 	int			 match;
 
+	mc = cpumem_enter(pfr_mcache);
+	if (mc->mc_kt == kt && mc->mc_af == af && mc->mc_gen == gen &&
+	    PF_AEQ(&mc->mc_addr, a, af)) {
+		match = mc->mc_match;
+		cpumem_leave(pfr_mcache, mc);
+		if (match)
+			kt->pfrkt_match++;
+		else
+			kt->pfrkt_nomatch++;
+		return (match);
+	}
+	cpumem_leave(pfr_mcache, mc);
+
 	ke = pfr_kentry_byaddr(kt, a, af, 0);
 
 	match = (ke && !(ke->pfrke_flags & PFRKE_FLAG_NOT));
@@ -2416,6 +2461,14 @@ pfr_match_addr(struct pfr_ktable *kt, struct pf_addr *a, sa_family_t af)
 	else
 		kt->pfrkt_nomatch++;
 
+	mc = cpumem_enter(pfr_mcache);
+	mc->mc_kt = kt;
+	mc->mc_af = af;
+	mc->mc_addr = *a;
+	mc->mc_match = match;
+	mc->mc_gen = gen;
+	cpumem_leave(pfr_mcache, mc);
+
 	return (match);
 }
 
@@ -816,6 +816,14 @@ TAILQ_HEAD(pf_rulequeue, pf_rule);
 
 struct pf_anchor;
 
+/* indices into the per-ruleset protocol start table */
+#define PF_START_OTHER	0
+#define PF_START_TCP	1
+#define PF_START_UDP	2
+#define PF_START_ICMP	3
+#define PF_START_ICMP6	4
+#define PF_START_COUNT	5
+
 struct pf_ruleset {
 	struct {
 		struct pf_rulequeue	 queues[2];
@@ -826,6 +834,7 @@ struct pf_ruleset {
 			int			 open;
 		}			 active, inactive;
 	}			 rules;
+	struct pf_rule		*proto_start[PF_START_COUNT];
 	struct pf_anchor	*anchor;
 	u_int32_t		 tticket;
 	int			 tables;
@@ -1597,6 +1606,8 @@ extern int			 pf_tbladdr_setup(struct pf_ruleset *,
 extern void			 pf_tbladdr_remove(struct pf_addr_wrap *);
 extern void			 pf_tbladdr_copyout(struct pf_addr_wrap *);
 extern void			 pf_calc_skip_steps(struct pf_rulequeue *);
+extern void			 pf_calc_proto_start(struct pf_ruleset *);
+extern int			 pf_proto_start_idx(u_int8_t);
 extern void			 pf_purge_expired_src_nodes(void);
 extern void			 pf_purge_expired_rules(void);
 extern void			 pf_remove_state(struct pf_state *);
@@ -1638,6 +1649,7 @@ int				 pf_setup_pdesc(struct pf_pdesc *, sa_family_t,
 				    u_short *);
 
 int	pf_test(sa_family_t, int, struct ifnet *, struct mbuf **);
+void	pf_test_pkts(sa_family_t, int, struct ifnet *, struct mbuf_list *);
 
 void	pf_poolmask(struct pf_addr *, struct pf_addr*,
 	    struct pf_addr *, struct pf_addr *, sa_family_t);
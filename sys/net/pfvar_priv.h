@@ -336,6 +336,7 @@ enum {
 };
 
 extern struct cpumem *pf_anchor_stack;
+extern struct cpumem *pf_skcache;
 
 enum pf_trans_type {
 	PF_TRANS_NONE,
@@ -40,9 +40,14 @@ extern struct mutex pipex_list_mtx;
 
 #define PIPEX_ENABLED			0x0001
 
-/* compile time option constants */
+/*
+ * compile time option constants.  PIPEX_MAX_SESSION only sizes the
+ * session hash tables, it does not limit the number of sessions; keep
+ * it near the expected session count so the chains walked per packet
+ * under pipex_list_mtx stay short.
+ */
 #ifndef	PIPEX_MAX_SESSION
-#define PIPEX_MAX_SESSION		512
+#define PIPEX_MAX_SESSION		8192
 #endif
 #define PIPEX_HASH_DIV			8
 #define PIPEX_HASH_SIZE			(PIPEX_MAX_SESSION/PIPEX_HASH_DIV)
@@ -151,6 +151,22 @@
 /* Give some jitter to hash, to avoid synchronization between routers. */
 static uint32_t		rt_hashjitter;
 
+/*
+ * Per-CPU cache of the last route returned by rt_match().  Forwarding
+ * between a handful of next hops keeps hitting the same few
+ * destinations, so one cached (rtableid, dst) -> rtentry probe saves
+ * the full ART descent.  The cache holds a reference on the entry and
+ * is invalidated as a whole by the rtgeneration bump that accompanies
+ * every routing table change.
+ */
+struct rt_cache {
+	struct rtentry		*rc_rt;		/* cached entry, referenced */
+	struct sockaddr_storage	 rc_dst;
+	u_long			 rc_gen;
+	unsigned int		 rc_tableid;
+};
+struct cpumem		*rt_match_cache;
+
 extern unsigned int	rtmap_limit;
 
 struct cpumem	*rtcounters;
@@ -189,6 +205,8 @@ void
 route_init(void)
 {
 	rtcounters = counters_alloc(rts_ncounters);
+	rt_match_cache = cpumem_malloc(sizeof(struct rt_cache),
+	    M_WAITOK|M_ZERO);
 
 	pool_init(&rtentry_pool, sizeof(struct rtentry), 0, IPL_MPFLOOR, 0,
 	    "rtentry", NULL);
@@ -314,7 +332,28 @@ struct rtentry *
 rt_match(const struct sockaddr *dst, uint32_t *src, int flags,
     unsigned int tableid)
 {
-	struct rtentry		*rt = NULL;
+	struct rt_cache		*rc;
+	struct rtentry		*rt = NULL, *ort;
+	u_long			 gen = rtgeneration;
+
+	/*
+	 * Multipath lookups hash on the source address, so only plain
+	 * destination lookups can be answered from the cache.
+	 */
+	if (src == NULL) {
+		rc = cpumem_enter(rt_match_cache);
+		rt = rc->rc_rt;
+		if (rt != NULL && rc->rc_gen == gen &&
+		    rc->rc_tableid == tableid &&
+		    dst->sa_len == rc->rc_dst.ss_len &&
+		    memcmp(&rc->rc_dst, dst, dst->sa_len) == 0) {
+			rtref(rt);
+			cpumem_leave(rt_match_cache, rc);
+			rt->rt_use++;
+			return (rt);
+		}
+		cpumem_leave(rt_match_cache, rc);
+	}
 
 	rt = rtable_match(tableid, dst, src);
 	if (rt == NULL) {
@@ -325,6 +364,19 @@ rt_match(const struct sockaddr *dst, uint32_t *src, int flags,
 	if (ISSET(rt->rt_flags, RTF_CLONING) && ISSET(flags, RT_RESOLVE))
 		rt_clone(&rt, dst, tableid);
 
+	if (src == NULL && !ISSET(rt->rt_flags, RTF_CLONING) &&
+	    dst->sa_len <= sizeof(struct sockaddr_storage)) {
+		rc = cpumem_enter(rt_match_cache);
+		ort = rc->rc_rt;
+		rc->rc_rt = rt;
+		rtref(rt);
+		memcpy(&rc->rc_dst, dst, dst->sa_len);
+		rc->rc_tableid = tableid;
+		rc->rc_gen = gen;
+		cpumem_leave(rt_match_cache, rc);
+		rtfree(ort);
+	}
+
 	rt->rt_use++;
 	return (rt);
 }
@@ -50,6 +50,7 @@
  *   -----------
  */
 struct srp	  *afmap;
+u_long		   rtgeneration;
 uint8_t		   af2idx[AF_MAX+1];	/* To only allocate supported AF */
 uint8_t		   af2idx_max;
 
@@ -644,6 +645,8 @@ rtable_insert(unsigned int rtableid, struct sockaddr *dst,
 		rtable_mpath_insert(an, rt);
 	}
 leave:
+	if (error == 0)
+		rtgeneration++;
 	rw_exit_write(&ar->ar_lock);
 	rtfree(rt);
 	return (error);
@@ -709,6 +712,8 @@ rtable_delete(unsigned int rtableid, const struct sockaddr *dst,
 	art_put(an);
 
 leave:
+	if (error == 0)
+		rtgeneration++;
 	rw_exit_write(&ar->ar_lock);
 	rtfree(rt);
 
@@ -830,6 +835,7 @@ rtable_mpath_reprio(unsigned int rtableid, struct sockaddr *dst,
 		rtfree(rt);
 		error = EAGAIN;
 	}
+	rtgeneration++;
 	rw_exit_write(&ar->ar_lock);
 
 	return (error);
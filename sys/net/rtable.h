@@ -31,6 +31,12 @@
 
 int		 rtable_satoplen(sa_family_t, const struct sockaddr *);
 
+/*
+ * Bumped on every visible routing table change; consumers caching
+ * lookup results compare it to detect staleness.
+ */
+extern u_long	 rtgeneration;
+
 void		 rtable_init(void);
 int		 rtable_exists(unsigned int);
 int		 rtable_empty(unsigned int);
@@ -120,6 +120,8 @@ struct pool inpcb_pool;
 void	in_pcbhash_insert(struct inpcb *);
 struct inpcb *in_pcbhash_lookup(struct inpcbtable *, uint64_t, u_int,
     const struct in_addr *, u_short, const struct in_addr *, u_short);
+struct inpcb *in_pcbhash_balance(struct inpcbtable *, struct inpcb *,
+    uint64_t, u_int, const struct in_addr *, u_short, uint32_t);
 int	in_pcbresize(struct inpcbtable *, int);
 
 #define	INPCBHASH_LOADFACTOR(_x)	(((_x) * 3) / 4)
@@ -1088,6 +1090,51 @@ in_pcbhash_lookup(struct inpcbtable *table, uint64_t hash, u_int rdomain,
 	return (inp);
 }
 
+/*
+ * If several sockets are bound to the same local address and port with
+ * SO_REUSEPORT, spread incoming flows over the group instead of always
+ * delivering to the first match.  Selection is by highest random weight
+ * over the packet flow id, which is stable for a flow independently of
+ * the hash chain order and only moves 1/N of the flows when the group
+ * membership changes.
+ */
+struct inpcb *
+in_pcbhash_balance(struct inpcbtable *table, struct inpcb *first,
+    uint64_t hash, u_int rdomain, const struct in_addr *laddr, u_short lport,
+    uint32_t flowid)
+{
+	struct inpcbhead *head;
+	struct inpcb *inp, *best = NULL;
+	uint32_t w, bestw = 0;
+
+	MUTEX_ASSERT_LOCKED(&table->inpt_mtx);
+
+	if (first == NULL ||
+	    !ISSET(first->inp_socket->so_options, SO_REUSEPORT))
+		return (first);
+
+	head = &table->inpt_hashtbl[hash & table->inpt_mask];
+	LIST_FOREACH(inp, head, inp_hash) {
+#ifdef INET6
+		if (ISSET(inp->inp_flags, INP_IPV6))
+			continue;
+#endif
+		if (inp->inp_fport != 0 || inp->inp_lport != lport ||
+		    inp->inp_faddr.s_addr != INADDR_ANY ||
+		    inp->inp_laddr.s_addr != laddr->s_addr ||
+		    rtable_l2(inp->inp_rtableid) != rdomain)
+			continue;
+		if (!ISSET(inp->inp_socket->so_options, SO_REUSEPORT))
+			continue;
+		w = (flowid ^ (uint32_t)(uintptr_t)inp) * 2654435761U;
+		if (best == NULL || w > bestw) {
+			best = inp;
+			bestw = w;
+		}
+	}
+	return (best != NULL ? best : first);
+}
+
 int
 in_pcbresize(struct inpcbtable *table, int hashsize)
 {
@@ -1238,11 +1285,19 @@ in_pcblookup_listen(struct inpcbtable *table, struct in_addr laddr,
 	mtx_enter(&table->inpt_mtx);
 	inp = in_pcbhash_lookup(table, hash, rdomain,
 	    &zeroin_addr, 0, key1, lport);
+	if (inp != NULL && m != NULL && ISSET(m->m_flags, M_FLOWID)) {
+		inp = in_pcbhash_balance(table, inp, hash, rdomain,
+		    key1, lport, m->m_pkthdr.ph_flowid);
+	}
 	if (inp == NULL && key1->s_addr != key2->s_addr) {
 		hash = in_pcbhash(table, rdomain,
 		    &zeroin_addr, 0, key2, lport);
 		inp = in_pcbhash_lookup(table, hash, rdomain,
 		    &zeroin_addr, 0, key2, lport);
+		if (inp != NULL && m != NULL && ISSET(m->m_flags, M_FLOWID)) {
+			inp = in_pcbhash_balance(table, inp, hash, rdomain,
+			    key2, lport, m->m_pkthdr.ph_flowid);
+		}
 	}
 	in_pcbref(inp);
 	mtx_leave(&table->inpt_mtx);
@@ -387,7 +387,10 @@ esp_input(struct mbuf **mp, struct tdb *tdb, int skip, int protoff)
 		    &btsx);
 		btsx = ntohl(btsx);
 
-		switch (checkreplaywindow(tdb, tdb->tdb_rpl, btsx, &esn, 0)) {
+		mtx_enter(&tdb->tdb_mtx);
+		error = checkreplaywindow(tdb, tdb->tdb_rpl, btsx, &esn, 0);
+		mtx_leave(&tdb->tdb_mtx);
+		switch (error) {
 		case 0: /* All's well */
 			break;
 		case 1:
@@ -419,7 +422,9 @@ esp_input(struct mbuf **mp, struct tdb *tdb, int skip, int protoff)
 	}
 
 	/* Update the counters */
+	mtx_enter(&tdb->tdb_mtx);
 	tdb->tdb_cur_bytes += plen;
+	mtx_leave(&tdb->tdb_mtx);
 	tdbstat_add(tdb, tdb_ibytes, plen);
 	espstat_add(esps_ibytes, plen);
 
@@ -543,7 +548,10 @@ esp_input(struct mbuf **mp, struct tdb *tdb, int skip, int protoff)
 		    &btsx);
 		btsx = ntohl(btsx);
 
-		switch (checkreplaywindow(tdb, tdb->tdb_rpl, btsx, &esn, 1)) {
+		mtx_enter(&tdb->tdb_mtx);
+		error = checkreplaywindow(tdb, tdb->tdb_rpl, btsx, &esn, 1);
+		mtx_leave(&tdb->tdb_mtx);
+		switch (error) {
 		case 0: /* All's well */
 #if NPFSYNC > 0
 			pfsync_update_tdb(tdb,0);
@@ -777,7 +785,9 @@ esp_output(struct mbuf *m, struct tdb *tdb, int skip, int protoff)
 	}
 
 	/* Update the counters. */
+	mtx_enter(&tdb->tdb_mtx);
 	tdb->tdb_cur_bytes += m->m_pkthdr.len - skip;
+	mtx_leave(&tdb->tdb_mtx);
 	espstat_add(esps_obytes, m->m_pkthdr.len - skip);
 
 	/* Hard byte expiration. */
@@ -839,7 +849,9 @@ esp_output(struct mbuf *m, struct tdb *tdb, int skip, int protoff)
 	/* Initialize ESP header. */
 	memcpy(mtod(mo, caddr_t) + roff, (caddr_t) &tdb->tdb_spi,
 	    sizeof(u_int32_t));
+	mtx_enter(&tdb->tdb_mtx);
 	replay64 = tdb->tdb_rpl++;	/* used for both header and ESN */
+	mtx_leave(&tdb->tdb_mtx);
 	replay = htonl((u_int32_t)replay64);
 	memcpy(mtod(mo, caddr_t) + roff + sizeof(u_int32_t), (caddr_t) &replay,
 	    sizeof(u_int32_t));
@@ -2,10 +2,10 @@
 
 /*
  * Copyright (c) 2008 Theo de Raadt, Ryan McBride
- * 
+ *
  * Slightly different algorithm from the one designed by
  * Matthew Dillon <dillon@backplane.com> for The DragonFly Project
- * 
+ *
  * Permission to use, copy, modify, and distribute this software for any
  * purpose with or without fee is hereby granted, provided that the above
  * copyright notice and this permission notice appear in all copies.
@@ -24,15 +24,37 @@
  * the 65536 entry ID space.  We reshuffle the ID we pick out of the array
  * into the previous 32767 cells, providing an guarantee that an ID will not
  * be reused for at least 32768 calls.
+ *
+ * Each CPU runs its own independent permutation so that ID generation
+ * does not bounce a shared cache line between CPUs.  The randomness that
+ * drives the shuffle is taken from the system PRNG in batches, which both
+ * amortizes the global PRNG lock over many packets and reseeds the
+ * per-CPU stream periodically.  The no-reuse guarantee holds per CPU.
  */
 #include <sys/param.h>
 #include <sys/systm.h>
+#include <sys/percpu.h>
 
-static u_int16_t ip_shuffle[65536];
-static int isindex = 0;
+struct ipid_state {
+	u_int16_t	is_shuffle[65536];
+	u_int16_t	is_rnd[256];	/* batched system PRNG output */
+	u_int		is_rndleft;
+	u_int		is_index;
+	int		is_initialized;
+};
 
+struct cpumem *ipid_state;
+
+void	ip_initid(void);
 u_int16_t ip_randomid(void);
 
+void
+ip_initid(void)
+{
+	ipid_state = cpumem_malloc(sizeof(struct ipid_state),
+	    M_WAITOK|M_ZERO);
+}
+
 /*
  * Return a random IP id.  Shuffle the new value we get into the previous half
  * of the ip_shuffle ring (-32767 or swap with ourself), to avoid duplicates
@@ -43,12 +65,14 @@ u_int16_t ip_randomid(void);
 u_int16_t
 ip_randomid(void)
 {
-	static int ipid_initialized;
+	struct ipid_state *ids;
 	u_int16_t si, r;
 	int i, i2;
 
-	if (!ipid_initialized) {
-		ipid_initialized = 1;
+	ids = cpumem_enter(ipid_state);
+
+	if (!ids->is_initialized) {
+		ids->is_initialized = 1;
 
 		/*
 		 * Initialize with a random permutation. Do so using Knuth
@@ -59,22 +83,28 @@ ip_randomid(void)
 		 * doing this until the first packet being sent and now must
 		 * generate an ID.
 		 */
-		for (i = 0; i < nitems(ip_shuffle); ++i) {
+		for (i = 0; i < nitems(ids->is_shuffle); ++i) {
 			i2 = arc4random_uniform(i + 1);
-			ip_shuffle[i] = ip_shuffle[i2];
-			ip_shuffle[i2] = i;
+			ids->is_shuffle[i] = ids->is_shuffle[i2];
+			ids->is_shuffle[i2] = i;
 		}
 	}
 
 	do {
-		arc4random_buf(&si, sizeof(si));
-		i = isindex & 0xFFFF;
-		i2 = (isindex - (si & 0x7FFF)) & 0xFFFF;
-		r = ip_shuffle[i];
-		ip_shuffle[i] = ip_shuffle[i2];
-		ip_shuffle[i2] = r;
-		isindex++;
+		if (ids->is_rndleft == 0) {
+			arc4random_buf(ids->is_rnd, sizeof(ids->is_rnd));
+			ids->is_rndleft = nitems(ids->is_rnd);
+		}
+		si = ids->is_rnd[--ids->is_rndleft];
+		i = ids->is_index & 0xFFFF;
+		i2 = (ids->is_index - (si & 0x7FFF)) & 0xFFFF;
+		r = ids->is_shuffle[i];
+		ids->is_shuffle[i] = ids->is_shuffle[i2];
+		ids->is_shuffle[i2] = r;
+		ids->is_index++;
 	} while (r == 0);
 
+	cpumem_leave(ipid_state, ids);
+
 	return (r);
 }
@@ -184,6 +184,8 @@ ip_init(void)
 
 	ipcounters = counters_alloc(ips_ncounters);
 
+	ip_initid();
+
 	pool_init(&ipqent_pool, sizeof(struct ipqent), 0,
 	    IPL_SOFTNET, 0, "ipqe",  NULL);
 	pool_init(&ipq_pool, sizeof(struct ipq), 0,
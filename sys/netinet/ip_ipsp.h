@@ -381,7 +381,7 @@ struct tdb {				/* tunnel descriptor block */
 
 	u_int64_t	tdb_exp_bytes;	/* Expire after so many bytes passed */
 	u_int64_t	tdb_soft_bytes;	/* Expiration warning */
-	u_int64_t	tdb_cur_bytes;	/* Current count of bytes */
+	u_int64_t	tdb_cur_bytes;	/* [m] Current count of bytes */
 
 	u_int64_t	tdb_exp_timeout;	/* When does the SPI expire */
 	u_int64_t	tdb_soft_timeout;	/* Send soft-expire warning */
@@ -418,8 +418,8 @@ struct tdb {				/* tunnel descriptor block */
 #define TDB_REPLAYWASTE	32
 #define TDB_REPLAYMAX	(2100+TDB_REPLAYWASTE)
 
-	u_int64_t	tdb_rpl;	/* Replay counter */
-	u_int32_t	tdb_seen[howmany(TDB_REPLAYMAX, 32)]; /* Anti-replay window */
+	u_int64_t	tdb_rpl;	/* [m] Replay counter */
+	u_int32_t	tdb_seen[howmany(TDB_REPLAYMAX, 32)]; /* [m] Anti-replay window */
 
 	u_int8_t	tdb_iv[4];	/* Used for HALF-IV ESP */
 
@@ -86,6 +86,7 @@
 
 #include <netinet/in.h>
 #include <netinet/ip.h>
+#include <netinet/if_ether.h>
 #include <netinet/in_pcb.h>
 #include <netinet/ip_var.h>
 #include <netinet6/ip6_var.h>
@@ -3092,7 +3093,7 @@ tcp_mss_adv(struct mbuf *m, int af)
  */
 
 /* syn hash parameters */
-int	tcp_syn_hash_size = TCP_SYN_HASH_SIZE;	/* [N] size of hash table */
+int	tcp_syn_hash_size = TCP_SYN_HASH_SIZE;	/* [S] size of hash table */
 int	tcp_syn_cache_limit =			/* [N] global entry limit */
 	    TCP_SYN_HASH_SIZE * TCP_SYN_BUCKET_SIZE;
 int	tcp_syn_bucket_limit =			/* [N] per bucket limit */
@@ -3248,6 +3249,16 @@ syn_cache_insert(struct syn_cache *sc, struct tcpcb *tp)
 		 * with random as soon as the passive syn cache gets empty.
 		 */
 		set->scs_use = 0;
+		/*
+		 * Long chains also build up when the hash is just too
+		 * small for the load.  Grow it for the next swap, the
+		 * resize is done when the passive cache is reused.
+		 */
+		if (tcp_syn_hash_size <= set->scs_size &&
+		    tcp_syn_hash_size < TCP_SYN_HASH_MAX) {
+			tcp_syn_hash_size = MIN(2 * tcp_syn_hash_size + 1,
+			    TCP_SYN_HASH_MAX);
+		}
 		/*
 		 * The bucket is full.  Toss the oldest element in the
 		 * bucket.  This will be the first entry in the bucket.
@@ -4166,3 +4177,243 @@ syn_cache_respond(struct syn_cache *sc, struct mbuf *m, uint64_t now)
 	}
 	return (error);
 }
+
+/*
+ * Software LRO.  Coalesce consecutive in-order TCP segments of the same
+ * flow into one large packet before it is passed up the stack, the same
+ * way IFCAP_LRO hardware does.  The large packet is marked M_TCP_TSO
+ * with ph_mss set to the original segment size, so forwarding can
+ * resegment it with TSO or tcp_chopper().  Only packets whose checksums
+ * have been verified by the hardware are candidates, the headers of the
+ * coalesced packet keep their checksum flags.
+ */
+
+struct tcp_lro_seg {
+	struct ip	*ls_ip;
+#ifdef INET6
+	struct ip6_hdr	*ls_ip6;
+#endif
+	struct tcphdr	*ls_th;
+	u_int		 ls_hlen;	/* ether + ip + tcp header length */
+	u_int		 ls_plen;	/* tcp payload length */
+};
+
+struct tcp_lro_state {
+	struct mbuf	*lro_m;		/* head of the current aggregate */
+	struct ip	*lro_ip;
+#ifdef INET6
+	struct ip6_hdr	*lro_ip6;
+#endif
+	struct tcphdr	*lro_th;
+	u_int32_t	 lro_seq;	/* next expected sequence number */
+	u_int		 lro_mss;	/* payload length of the segments */
+	u_int		 lro_npkts;	/* number of coalesced segments */
+};
+
+int	 tcp_softlro_parse(struct mbuf *, struct tcp_lro_seg *);
+int	 tcp_softlro_match(struct tcp_lro_state *, struct tcp_lro_seg *);
+void	 tcp_softlro_flush(struct tcp_lro_state *, struct mbuf_list *);
+
+int
+tcp_softlro_parse(struct mbuf *m, struct tcp_lro_seg *seg)
+{
+	struct ether_header *eh;
+	struct tcphdr *th;
+	u_int hlen, iphlen;
+
+	memset(seg, 0, sizeof(*seg));
+
+	if (m->m_len < ETHER_HDR_LEN + sizeof(struct ip))
+		return (-1);
+	eh = mtod(m, struct ether_header *);
+	switch (ntohs(eh->ether_type)) {
+	case ETHERTYPE_IP: {
+		struct ip *ip;
+
+		/* both checksums must have been verified by the driver */
+		if (!ISSET(m->m_pkthdr.csum_flags, M_IPV4_CSUM_IN_OK) ||
+		    !ISSET(m->m_pkthdr.csum_flags, M_TCP_CSUM_IN_OK) ||
+		    ISSET(m->m_pkthdr.csum_flags, M_TCP_CSUM_IN_BAD))
+			return (-1);
+		ip = (struct ip *)(mtod(m, caddr_t) + ETHER_HDR_LEN);
+		iphlen = ip->ip_hl << 2;
+		if (ip->ip_v != IPVERSION || iphlen != sizeof(struct ip) ||
+		    ip->ip_p != IPPROTO_TCP ||
+		    ISSET(ip->ip_off, htons(IP_OFFMASK | IP_MF)))
+			return (-1);
+		/* watch out for trailing ether padding */
+		if (ntohs(ip->ip_len) != m->m_pkthdr.len - ETHER_HDR_LEN)
+			return (-1);
+		seg->ls_ip = ip;
+		break;
+	}
+#ifdef INET6
+	case ETHERTYPE_IPV6: {
+		struct ip6_hdr *ip6;
+
+		if (!ISSET(m->m_pkthdr.csum_flags, M_TCP_CSUM_IN_OK) ||
+		    ISSET(m->m_pkthdr.csum_flags, M_TCP_CSUM_IN_BAD))
+			return (-1);
+		if (m->m_len < ETHER_HDR_LEN + sizeof(struct ip6_hdr))
+			return (-1);
+		ip6 = (struct ip6_hdr *)(mtod(m, caddr_t) + ETHER_HDR_LEN);
+		iphlen = sizeof(struct ip6_hdr);
+		if ((ip6->ip6_vfc & IPV6_VERSION_MASK) != IPV6_VERSION ||
+		    ip6->ip6_nxt != IPPROTO_TCP)
+			return (-1);
+		if (ntohs(ip6->ip6_plen) != m->m_pkthdr.len - ETHER_HDR_LEN -
+		    sizeof(struct ip6_hdr))
+			return (-1);
+		seg->ls_ip6 = ip6;
+		break;
+	}
+#endif
+	default:
+		return (-1);
+	}
+
+	if (m->m_len < ETHER_HDR_LEN + iphlen + sizeof(struct tcphdr))
+		return (-1);
+	th = (struct tcphdr *)(mtod(m, caddr_t) + ETHER_HDR_LEN + iphlen);
+	hlen = ETHER_HDR_LEN + iphlen + (th->th_off << 2);
+	if (th->th_off < sizeof(struct tcphdr) >> 2 || m->m_len < hlen)
+		return (-1);
+	/* only bulk data segments are worth coalescing */
+	if ((th->th_flags & ~(TH_ACK | TH_PUSH)) != 0 ||
+	    !ISSET(th->th_flags, TH_ACK) || m->m_pkthdr.len <= hlen)
+		return (-1);
+
+	seg->ls_th = th;
+	seg->ls_hlen = hlen;
+	seg->ls_plen = m->m_pkthdr.len - hlen;
+	return (0);
+}
+
+int
+tcp_softlro_match(struct tcp_lro_state *lro, struct tcp_lro_seg *seg)
+{
+	struct tcphdr *th = lro->lro_th;
+
+	if (seg->ls_ip != NULL) {
+		struct ip *ip = lro->lro_ip;
+
+		if (ip == NULL ||
+		    ip->ip_src.s_addr != seg->ls_ip->ip_src.s_addr ||
+		    ip->ip_dst.s_addr != seg->ls_ip->ip_dst.s_addr ||
+		    ip->ip_ttl != seg->ls_ip->ip_ttl ||
+		    ip->ip_tos != seg->ls_ip->ip_tos)
+			return (0);
+	}
+#ifdef INET6
+	else {
+		struct ip6_hdr *ip6 = lro->lro_ip6;
+
+		if (ip6 == NULL ||
+		    !IN6_ARE_ADDR_EQUAL(&ip6->ip6_src, &seg->ls_ip6->ip6_src) ||
+		    !IN6_ARE_ADDR_EQUAL(&ip6->ip6_dst, &seg->ls_ip6->ip6_dst) ||
+		    ip6->ip6_hlim != seg->ls_ip6->ip6_hlim)
+			return (0);
+	}
+#endif
+	if (th->th_sport != seg->ls_th->th_sport ||
+	    th->th_dport != seg->ls_th->th_dport ||
+	    th->th_off != seg->ls_th->th_off)
+		return (0);
+	/* segments must be in order and of the size the chopper rebuilds */
+	if (ntohl(seg->ls_th->th_seq) != lro->lro_seq ||
+	    seg->ls_plen > lro->lro_mss)
+		return (0);
+	/* the coalesced length must still fit the ip header */
+	if (lro->lro_m->m_pkthdr.len - ETHER_HDR_LEN + seg->ls_plen >
+	    IP_MAXPACKET)
+		return (0);
+	return (1);
+}
+
+void
+tcp_softlro_flush(struct tcp_lro_state *lro, struct mbuf_list *ml)
+{
+	struct mbuf *m = lro->lro_m;
+
+	if (m == NULL)
+		return;
+	if (lro->lro_npkts > 1) {
+		if (lro->lro_ip != NULL) {
+			lro->lro_ip->ip_len = htons(m->m_pkthdr.len -
+			    ETHER_HDR_LEN);
+			/* the length changed, the header checksum is stale */
+			SET(m->m_pkthdr.csum_flags, M_IPV4_CSUM_IN_OK);
+		}
+#ifdef INET6
+		else if (lro->lro_ip6 != NULL) {
+			lro->lro_ip6->ip6_plen = htons(m->m_pkthdr.len -
+			    ETHER_HDR_LEN - sizeof(struct ip6_hdr));
+		}
+#endif
+		SET(m->m_pkthdr.csum_flags, M_TCP_TSO);
+		m->m_pkthdr.ph_mss = lro->lro_mss;
+		tcpstat_inc(tcps_inswlro);
+		tcpstat_add(tcps_inpktlro, lro->lro_npkts);
+	}
+	ml_enqueue(ml, m);
+	lro->lro_m = NULL;
+	lro->lro_npkts = 0;
+}
+
+void
+tcp_softlro(struct mbuf_list *ml)
+{
+	struct tcp_lro_state lro;
+	struct mbuf_list mlout;
+	struct mbuf *m;
+
+	memset(&lro, 0, sizeof(lro));
+	ml_init(&mlout);
+
+	while ((m = ml_dequeue(ml)) != NULL) {
+		struct tcp_lro_seg seg;
+
+		if (tcp_softlro_parse(m, &seg) != 0) {
+			tcp_softlro_flush(&lro, &mlout);
+			ml_enqueue(&mlout, m);
+			continue;
+		}
+		if (lro.lro_m != NULL && !tcp_softlro_match(&lro, &seg))
+			tcp_softlro_flush(&lro, &mlout);
+		if (lro.lro_m == NULL) {
+			/* start a new candidate aggregate */
+			lro.lro_m = m;
+			lro.lro_ip = seg.ls_ip;
+#ifdef INET6
+			lro.lro_ip6 = seg.ls_ip6;
+#endif
+			lro.lro_th = seg.ls_th;
+			lro.lro_seq = ntohl(seg.ls_th->th_seq) + seg.ls_plen;
+			lro.lro_mss = seg.ls_plen;
+			lro.lro_npkts = 1;
+			if (ISSET(seg.ls_th->th_flags, TH_PUSH))
+				tcp_softlro_flush(&lro, &mlout);
+			continue;
+		}
+
+		/* append the payload, the latest ack and window win */
+		lro.lro_th->th_ack = seg.ls_th->th_ack;
+		lro.lro_th->th_win = seg.ls_th->th_win;
+		lro.lro_th->th_flags |= seg.ls_th->th_flags & TH_PUSH;
+		lro.lro_seq += seg.ls_plen;
+		lro.lro_npkts++;
+		lro.lro_m->m_pkthdr.len += seg.ls_plen;
+
+		m_adj(m, seg.ls_hlen);
+		m_removehdr(m);
+		m_cat(lro.lro_m, m);
+
+		/* a short or pushed segment has to end the aggregate */
+		if (seg.ls_plen < lro.lro_mss ||
+		    ISSET(lro.lro_th->th_flags, TH_PUSH))
+			tcp_softlro_flush(&lro, &mlout);
+	}
+	tcp_softlro_flush(&lro, &mlout);
+
+	*ml = mlout;
+}
@@ -123,7 +123,7 @@ int	tcp_do_rfc3390 = 2;	/* Increase TCP's Initial Window to 10*mss */
 int	tcp_do_tso = 1;		/* TCP segmentation offload for output */
 
 #ifndef TCB_INITIAL_HASH_SIZE
-#define	TCB_INITIAL_HASH_SIZE	128
+#define	TCB_INITIAL_HASH_SIZE	1024
 #endif
 
 int tcp_reass_limit = NMBCLUSTERS / 8; /* hardlimit for tcpqe_pool */
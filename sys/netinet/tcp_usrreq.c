@@ -1463,7 +1463,7 @@ tcp_sysctl(int *name, u_int namelen, void *oldp, size_t *oldlenp, void *newp,
 		NET_LOCK();
 		nval = tcp_syn_hash_size;
 		error = sysctl_int_bounded(oldp, oldlenp, newp, newlen,
-		    &nval, 1, 100000);
+		    &nval, 1, TCP_SYN_HASH_MAX);
 		if (!error && nval != tcp_syn_hash_size) {
 			/*
 			 * If global hash size has been changed,
@@ -235,6 +235,7 @@ struct tcp_opt_info {
 extern struct mutex syn_cache_mtx;
 
 #define	TCP_SYN_HASH_SIZE	293
+#define	TCP_SYN_HASH_MAX	100000
 #define	TCP_SYN_BUCKET_SIZE	35
 
 union syn_cache_sa {
@@ -734,6 +735,7 @@ int	 tcp_output(struct tcpcb *);
 int	 tcp_chopper(struct mbuf *, struct mbuf_list *, struct ifnet *, u_int);
 int	 tcp_if_output_tso(struct ifnet *, struct mbuf **, struct sockaddr *,
 	    struct rtentry *, uint32_t, u_int);
+void	 tcp_softlro(struct mbuf_list *);
 void	 tcp_pulloutofband(struct socket *, u_int, struct mbuf *, int);
 int	 tcp_reass(struct tcpcb *, struct tcphdr *, struct mbuf *, int *);
 void	 tcp_rscale(struct tcpcb *, u_long);
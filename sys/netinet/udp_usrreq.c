@@ -176,7 +176,7 @@ void	udp_notify(struct inpcb *, int);
 int	udp_sysctl_udpstat(void *, size_t *, void *);
 
 #ifndef	UDB_INITIAL_HASH_SIZE
-#define	UDB_INITIAL_HASH_SIZE	128
+#define	UDB_INITIAL_HASH_SIZE	1024
 #endif
 
 void
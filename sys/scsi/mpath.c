@@ -54,7 +54,8 @@ struct mpath_dev {
 
 	struct mpath_groups	 d_groups;
 
-	struct mpath_group	*d_failover_iter;
+	struct mpath_path	*d_failover_found;
+	u_int			 d_failover_probes;
 	struct timeout		 d_failover_tmo;
 	u_int			 d_failover;
 
@@ -92,7 +93,6 @@ void		mpath_done(struct scsi_xfer *);
 
 void		mpath_failover(struct mpath_dev *);
 void		mpath_failover_start(void *);
-void		mpath_failover_check(struct mpath_dev *);
 
 const struct scsi_adapter mpath_switch = {
 	mpath_cmd, NULL, mpath_probe, NULL, NULL
@@ -344,26 +344,47 @@ void
 mpath_failover_start(void *xd)
 {
 	struct mpath_dev *d = xd;
+	struct mpath_group *g;
+	struct scsi_link **links;
+	u_int i, nlinks, probes = 0;
 
 	mtx_enter(&d->d_mtx);
-	d->d_failover_iter = TAILQ_FIRST(&d->d_groups);
+	TAILQ_FOREACH(g, &d->d_groups, g_entry)
+		probes++;
 	mtx_leave(&d->d_mtx);
 
-	mpath_failover_check(d);
-}
-
-void
-mpath_failover_check(struct mpath_dev *d)
-{
-	struct mpath_group *g = d->d_failover_iter;
-	struct mpath_path *p;
+	if (probes == 0) {
+		timeout_add_sec(&d->d_failover_tmo, 1);
+		return;
+	}
 
-	if (g == NULL)
+	links = mallocarray(probes, sizeof(*links), M_TEMP, M_NOWAIT);
+	if (links == NULL) {
 		timeout_add_sec(&d->d_failover_tmo, 1);
-	else {
-		p = TAILQ_FIRST(&g->g_paths);
-		d->d_ops->op_status(p->p_link);
+		return;
 	}
+
+	mtx_enter(&d->d_mtx);
+	d->d_failover_found = NULL;
+	nlinks = 0;
+	TAILQ_FOREACH(g, &d->d_groups, g_entry) {
+		if (nlinks >= probes)
+			break;
+		links[nlinks++] = TAILQ_FIRST(&g->g_paths)->p_link;
+	}
+	d->d_failover_probes = nlinks;
+	mtx_leave(&d->d_mtx);
+
+	/*
+	 * Probe the first path of every group at once rather than one
+	 * group after the other.  I/O resumes as soon as the fastest
+	 * healthy path answers instead of waiting out the command
+	 * timeouts of every dead path in front of it.
+	 */
+	for (i = 0; i < nlinks; i++)
+		d->d_ops->op_status(links[i]);
+
+	free(links, M_TEMP, probes * sizeof(*links));
 }
 
 void
@@ -371,22 +392,35 @@ mpath_path_status(struct mpath_path *p, int status)
 {
 	struct mpath_group *g = p->p_group;
 	struct mpath_dev *d = g->g_dev;
+	int activate = 0;
+	u_int left;
 
 	mtx_enter(&d->d_mtx);
-	if (status == MPATH_S_ACTIVE) {
+	if (status == MPATH_S_ACTIVE && d->d_failover_found == NULL) {
+		d->d_failover_found = p;
+		d->d_next_path = p;
+		activate = 1;
+	}
+	left = --d->d_failover_probes;
+	if (left == 0 && d->d_failover_found != NULL) {
+		/* prefer the group that answered for future selection */
+		g = d->d_failover_found->p_group;
 		TAILQ_REMOVE(&d->d_groups, g, g_entry);
 		TAILQ_INSERT_HEAD(&d->d_groups, g, g_entry);
-		d->d_next_path = p;
-	} else
-		d->d_failover_iter = TAILQ_NEXT(d->d_failover_iter, g_entry);
+	}
 	mtx_leave(&d->d_mtx);
 
-	if (status == MPATH_S_ACTIVE) {
+	if (activate)
 		scsi_xsh_add(&p->p_xsh);
-		if (!scsi_pending_finish(&d->d_mtx, &d->d_failover))
-			mpath_failover_start(d);
-	} else
-		mpath_failover_check(d);
+
+	/* the probe round is over once the slowest probe has answered */
+	if (left != 0)
+		return;
+
+	if (d->d_failover_found == NULL)
+		timeout_add_sec(&d->d_failover_tmo, 1);
+	else if (!scsi_pending_finish(&d->d_mtx, &d->d_failover))
+		mpath_failover_start(d);
 }
 
 void
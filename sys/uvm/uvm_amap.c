@@ -552,7 +552,7 @@ amap_copy(struct vm_map *map, struct vm_map_entry *entry, int waitf,
 	struct vm_amap *amap, *srcamap;
 	int slots, lcv, lazyalloc = 0;
 	vaddr_t chunksize;
-	int i, j, k, n, srcslot;
+	int i, j, k, n, srcslot, usedmap;
 	struct vm_amap_chunk *chunk = NULL, *srcchunk = NULL;
 	struct vm_anon *anon;
 
@@ -660,6 +660,17 @@ amap_copy(struct vm_map *map, struct vm_map_entry *entry, int waitf,
 		if (srcchunk == NULL)
 			continue;
 
+		/*
+		 * Only allocate a destination chunk if the source has
+		 * anons within the covered range.  This keeps the cost
+		 * of the copy proportional to the anons present rather
+		 * than to the size of the region, which matters for
+		 * sparsely populated amaps of large heaps at fork time.
+		 */
+		usedmap = (srcchunk->ac_usedmap >> j) & ((1 << n) - 1);
+		if (usedmap == 0)
+			continue;
+
 		chunk = amap_chunk_get(amap, lcv, 1, PR_NOWAIT);
 		if (chunk == NULL) {
 			/* amap_wipeout() releases the lock. */
@@ -668,14 +679,14 @@ amap_copy(struct vm_map *map, struct vm_map_entry *entry, int waitf,
 			return;
 		}
 
-		for (k = 0; k < n; i++, j++, k++) {
-			chunk->ac_anon[i] = anon = srcchunk->ac_anon[j];
-			if (anon == NULL)
-				continue;
-
+		for (k = ffs(usedmap); k != 0; k = ffs(usedmap)) {
+			k--;
+			usedmap ^= 1 << k;
+			chunk->ac_anon[i + k] = anon = srcchunk->ac_anon[j + k];
+			KASSERT(anon != NULL);
 			KASSERT(anon->an_lock == srcamap->am_lock);
 			KASSERT(anon->an_ref > 0);
-			chunk->ac_usedmap |= (1 << i);
+			chunk->ac_usedmap |= (1 << (i + k));
 			anon->an_ref++;
 			amap->am_nused++;
 		}
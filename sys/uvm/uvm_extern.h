@@ -431,6 +431,7 @@ void			uvm_aio_biodone(struct buf *);
 void			uvm_aio_aiodone(struct buf *);
 void			uvm_pageout(void *);
 void			uvm_aiodone_daemon(void *);
+extern int		uvmpd_batchfactor;
 void			uvm_wait(const char *);
 int			uvm_pglistalloc(psize_t, paddr_t, paddr_t,
 			    paddr_t, paddr_t, struct pglist *, int, int);
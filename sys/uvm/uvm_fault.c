@@ -153,13 +153,17 @@ struct uvm_advice {
  */
 static struct uvm_advice uvmadvice[MADV_MASK + 1];
 
-#define UVM_MAXRANGE 16	/* must be max() of nback+nforw+1 */
+#define UVM_MAXRANGE 64	/* must be max() of nback+nforw+1 */
 
 /*
  * private prototypes
  */
 static void uvmfault_amapcopy(struct uvm_faultinfo *);
 static inline void uvmfault_anonflush(struct vm_anon **, int);
+static int uvmfault_anonget_cluster(struct uvm_faultinfo *, struct vm_amap *,
+    struct vm_anon *, struct vm_page **);
+static void uvmfault_anonget_cluster_done(struct vm_page **, int,
+    struct vm_page *, int);
 void	uvmfault_unlockmaps(struct uvm_faultinfo *, boolean_t);
 void	uvmfault_update_stats(struct uvm_faultinfo *);
 
@@ -204,14 +208,14 @@ uvmfault_init(void)
 {
 	int npages;
 
-	npages = atop(16384);
+	npages = atop(65536);
 	if (npages > 0) {
 		KASSERT(npages <= UVM_MAXRANGE / 2);
 		uvmadvice[MADV_NORMAL].nforw = npages;
 		uvmadvice[MADV_NORMAL].nback = npages - 1;
 	}
 
-	npages = atop(32768);
+	npages = atop(131072);
 	if (npages > 0) {
 		KASSERT(npages <= UVM_MAXRANGE / 2);
 		uvmadvice[MADV_SEQUENTIAL].nforw = npages - 1;
@@ -262,6 +266,169 @@ uvmfault_amapcopy(struct uvm_faultinfo *ufi)
 	/*NOTREACHED*/
 }
 
+/*
+ * uvmfault_anonget_cluster: look for anons neighboring the faulting one
+ * whose pages sit on contiguous swap slots, and allocate pages for them
+ * so that the whole run can be read back with a single I/O.
+ *
+ * => called with the amap locked, before the fault drops its locks.
+ * => every page in "pgs" has PG_BUSY set and is owned by its anon; the
+ *    pages are in swap slot order, with the faulting page among them.
+ * => returns the number of pages placed in "pgs".
+ */
+static int
+uvmfault_anonget_cluster(struct uvm_faultinfo *ufi, struct vm_amap *amap,
+    struct vm_anon *anon, struct vm_page **pgs)
+{
+	struct vm_page *bpgs[SWCLUSTPAGES], *npg;
+	struct vm_anon *nanon;
+	struct vm_aref *aref;
+	vsize_t entsize;
+	voff_t off;
+	int i, nback, nforw, npgs;
+
+	pgs[0] = anon->an_page;
+	npgs = 1;
+
+	/*
+	 * The swap_off path calls us without fault info.  The slot check
+	 * also keeps us away from SWSLOT_BAD and resident-only anons.
+	 */
+	if (ufi == NULL || anon->an_swslot <= 0)
+		return npgs;
+
+	aref = &ufi->entry->aref;
+	off = ufi->orig_rvaddr - ufi->entry->start;
+	entsize = ufi->entry->end - ufi->entry->start;
+	KASSERT(amap_lookup(aref, off) == anon);
+
+	/*
+	 * Walk backwards, then forwards, for as long as the neighboring
+	 * anons' swap slots stay contiguous with the faulting one.
+	 */
+	nback = 0;
+	for (i = 1; i < SWCLUSTPAGES; i++) {
+		if (ptoa((vaddr_t)i) > off || anon->an_swslot - i <= 0)
+			break;
+		nanon = amap_lookup(aref, off - ptoa(i));
+		if (nanon == NULL || nanon->an_lock != amap->am_lock ||
+		    nanon->an_page != NULL ||
+		    nanon->an_swslot != anon->an_swslot - i)
+			break;
+		npg = uvm_pagealloc(NULL, 0, nanon, 0);
+		if (npg == NULL)
+			break;
+		bpgs[nback++] = npg;
+	}
+	nforw = 0;
+	for (i = 1; nback + 1 + nforw < SWCLUSTPAGES; i++) {
+		if (off + ptoa((vaddr_t)i) >= entsize)
+			break;
+		nanon = amap_lookup(aref, off + ptoa(i));
+		if (nanon == NULL || nanon->an_lock != amap->am_lock ||
+		    nanon->an_page != NULL ||
+		    nanon->an_swslot != anon->an_swslot + i)
+			break;
+		npg = uvm_pagealloc(NULL, 0, nanon, 0);
+		if (npg == NULL)
+			break;
+		pgs[nback + 1 + nforw] = npg;
+		nforw++;
+	}
+
+	for (i = 0; i < nback; i++)
+		pgs[i] = bpgs[nback - 1 - i];
+	pgs[nback] = anon->an_page;
+	npgs = nback + 1 + nforw;
+
+	/*
+	 * Contiguous drum slots can still straddle a swap device
+	 * boundary; fall back to a single page read if they do.
+	 */
+	if (npgs > 1 &&
+	    !uvm_swap_samedev(pgs[0]->uanon->an_swslot, npgs)) {
+		for (i = 0; i < npgs; i++) {
+			npg = pgs[i];
+			if (npg == anon->an_page)
+				continue;
+			npg->uanon->an_page = NULL;
+			uvm_lock_pageq();
+			uvm_pagefree(npg);
+			uvm_unlock_pageq();
+		}
+		pgs[0] = anon->an_page;
+		npgs = 1;
+	}
+
+	return npgs;
+}
+
+/*
+ * uvmfault_anonget_cluster_done: unbusy the readahead pages of a
+ * clustered swap-in.  The faulting page itself is left to the caller.
+ *
+ * => called with the amap, and thus every anon involved, locked again.
+ */
+static void
+uvmfault_anonget_cluster_done(struct vm_page **pgs, int npgs,
+    struct vm_page *pg, int error)
+{
+	struct vm_anon *nanon;
+	struct vm_page *npg;
+	struct rwlock *lock;
+	int i;
+
+	for (i = 0; i < npgs; i++) {
+		npg = pgs[i];
+		if (npg == pg)
+			continue;
+		nanon = npg->uanon;
+		KASSERT(nanon != NULL && nanon->an_page == npg);
+
+		if (npg->pg_flags & PG_WANTED)
+			wakeup(npg);
+
+		if (npg->pg_flags & PG_RELEASED) {
+			/*
+			 * The anon was freed while everything was
+			 * unlocked.  Do what uvm_anon_release() would,
+			 * except that the shared amap lock stays held;
+			 * only the extra reference taken when the anon
+			 * was released is dropped.
+			 */
+			KASSERT(nanon->an_ref == 0);
+			lock = nanon->an_lock;
+			uvm_lock_pageq();
+			pmap_page_protect(npg, PROT_NONE);
+			uvm_pagefree(npg);
+			uvm_unlock_pageq();
+			uvm_anfree(nanon);
+			rw_obj_free(lock);
+			continue;
+		}
+
+		if (error != VM_PAGER_OK) {
+			/*
+			 * Speculative read failed; drop the page but do
+			 * not mark the slot bad - a later single page
+			 * fault will retry and report its own error.
+			 */
+			nanon->an_page = NULL;
+			uvm_lock_pageq();
+			uvm_pagefree(npg);
+			uvm_unlock_pageq();
+			continue;
+		}
+
+		atomic_clearbits_int(&npg->pg_flags,
+		    PG_WANTED|PG_BUSY|PG_FAKE);
+		UVM_PAGE_OWN(npg, NULL);
+		uvm_lock_pageq();
+		uvm_pageactivate(npg);
+		uvm_unlock_pageq();
+	}
+}
+
 /*
  * uvmfault_anonget: get data in an anon into a non-busy, non-released
  * page in that anon.
@@ -277,8 +444,8 @@ int
 uvmfault_anonget(struct uvm_faultinfo *ufi, struct vm_amap *amap,
     struct vm_anon *anon)
 {
-	struct vm_page *pg;
-	int error;
+	struct vm_page *pg, *pgs[SWCLUSTPAGES];
+	int error, npgs;
 
 	KASSERT(rw_lock_held(anon->an_lock));
 	KASSERT(anon->an_lock == amap->am_lock);
@@ -301,6 +468,7 @@ uvmfault_anonget(struct uvm_faultinfo *ufi, struct vm_amap *amap,
 		 * Note: 'we_own' will become true if we set PG_BUSY on a page.
 		 */
 		we_own = FALSE;
+		npgs = 0;
 		pg = anon->an_page;
 
 		/*
@@ -347,18 +515,31 @@ uvmfault_anonget(struct uvm_faultinfo *ufi, struct vm_amap *amap,
 			} else {
 				/* PG_BUSY bit is set. */
 				we_own = TRUE;
+
+				/*
+				 * Before unlocking, look for neighboring
+				 * anons with contiguous swap slots, so the
+				 * whole run can be fetched with one I/O.
+				 */
+				npgs = uvmfault_anonget_cluster(ufi, amap,
+				    anon, pgs);
 				uvmfault_unlockall(ufi, amap, NULL);
 
 				/*
-				 * Pass a PG_BUSY+PG_FAKE+PG_CLEAN page into
+				 * Pass PG_BUSY+PG_FAKE+PG_CLEAN pages into
 				 * the uvm_swap_get() function with all data
 				 * structures unlocked.  Note that it is OK
 				 * to read an_swslot here, because we hold
-				 * PG_BUSY on the page.
+				 * PG_BUSY on the pages.
 				 */
 				counters_inc(uvmexp_counters, pageins);
-				error = uvm_swap_get(pg, anon->an_swslot,
-				    PGO_SYNCIO);
+				if (npgs > 1)
+					error = uvm_swap_getpages(pgs,
+					    pgs[0]->uanon->an_swslot, npgs,
+					    PGO_SYNCIO);
+				else
+					error = uvm_swap_get(pg,
+					    anon->an_swslot, PGO_SYNCIO);
 
 				/*
 				 * We clean up after the I/O below in the
@@ -386,6 +567,14 @@ uvmfault_anonget(struct uvm_faultinfo *ufi, struct vm_amap *amap,
 		 *    case (i.e. drop anon lock if not locked).
 		 */
 		if (we_own) {
+			/*
+			 * Unbusy any readahead pages first; the faulting
+			 * page itself is dealt with below.
+			 */
+			if (npgs > 1)
+				uvmfault_anonget_cluster_done(pgs, npgs, pg,
+				    error);
+
 			if (pg->pg_flags & PG_WANTED) {
 				wakeup(pg);
 			}
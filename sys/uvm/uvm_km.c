@@ -149,6 +149,29 @@ struct uvm_constraint_range	no_constraint = { 0x0, (paddr_t)-1 };
  */
 static struct vm_map		kernel_map_store;
 
+/*
+ * Per-CPU quantum caches of kernel VA for the most common km_alloc()
+ * sizes.  Ranges are parked here by km_free() with their pages already
+ * released and handed back out by km_alloc(), so the hot path does not
+ * take the kernel map lock; the map is only entered on refill and when
+ * a cache overflows.  The per-CPU mutexes are never contended unless
+ * an interrupt comes in on the same CPU.
+ */
+#define UVM_KM_QUANTUMS		3	/* 1, 2 and 4 page classes */
+#define UVM_KM_QDEPTH		8	/* cached ranges per class */
+
+struct uvm_km_qcache {
+	struct mutex	ukq_mtx;
+	vaddr_t		ukq_va[UVM_KM_QUANTUMS][UVM_KM_QDEPTH];
+	int		ukq_nva[UVM_KM_QUANTUMS];
+} __aligned(64);
+
+struct uvm_km_qcache	uvm_km_qcaches[MAXCPUS];
+
+static int	uvm_km_qclass(size_t);
+static vaddr_t	uvm_km_qget(size_t);
+static int	uvm_km_qput(vaddr_t, size_t);
+
 /*
  * uvm_km_init: init kernel maps and objects to reflect reality (i.e.
  * KVM already allocated for text, data, bss, and static data structures).
@@ -160,6 +183,8 @@ static struct vm_map		kernel_map_store;
 void
 uvm_km_init(vaddr_t base, vaddr_t start, vaddr_t end)
 {
+	int i;
+
 	/* kernel_object: for pageable anonymous kernel memory */
 	uao_init();
 	uvm.kernel_object = uao_create(VM_KERNEL_SPACE_SIZE, UAO_FLAG_KERNOBJ);
@@ -183,6 +208,9 @@ uvm_km_init(vaddr_t base, vaddr_t start, vaddr_t end)
 		panic("uvm_km_init: could not reserve space for kernel");
 	
 	kernel_map = &kernel_map_store;
+
+	for (i = 0; i < MAXCPUS; i++)
+		mtx_init(&uvm_km_qcaches[i].ukq_mtx, IPL_VM);
 }
 
 /*
@@ -720,6 +748,70 @@ uvm_km_doputpage(struct uvm_km_free_page *fp)
 }
 #endif	/* !__HAVE_PMAP_DIRECT */
 
+/*
+ * uvm_km_qclass: map an allocation size to its quantum cache class,
+ * or -1 if the size is not cached.
+ */
+static int
+uvm_km_qclass(size_t sz)
+{
+	switch (atop(sz)) {
+	case 1:
+		return 0;
+	case 2:
+		return 1;
+	case 4:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+/*
+ * uvm_km_qget: try to pop a cached VA range of the given size off the
+ * local CPU's quantum cache.  Returns 0 on a miss.
+ */
+static vaddr_t
+uvm_km_qget(size_t sz)
+{
+	struct uvm_km_qcache *ukq = &uvm_km_qcaches[cpu_number()];
+	vaddr_t va = 0;
+	int q;
+
+	if ((q = uvm_km_qclass(sz)) == -1)
+		return 0;
+
+	mtx_enter(&ukq->ukq_mtx);
+	if (ukq->ukq_nva[q] > 0)
+		va = ukq->ukq_va[q][--ukq->ukq_nva[q]];
+	mtx_leave(&ukq->ukq_mtx);
+
+	return va;
+}
+
+/*
+ * uvm_km_qput: park a VA range on the local CPU's quantum cache.
+ * Returns 0 if the range is not cacheable and must be unmapped.
+ */
+static int
+uvm_km_qput(vaddr_t va, size_t sz)
+{
+	struct uvm_km_qcache *ukq = &uvm_km_qcaches[cpu_number()];
+	int q, cached = 0;
+
+	if ((q = uvm_km_qclass(sz)) == -1)
+		return 0;
+
+	mtx_enter(&ukq->ukq_mtx);
+	if (ukq->ukq_nva[q] < UVM_KM_QDEPTH) {
+		ukq->ukq_va[q][ukq->ukq_nva[q]++] = va;
+		cached = 1;
+	}
+	mtx_leave(&ukq->ukq_mtx);
+
+	return cached;
+}
+
 void *
 km_alloc(size_t sz, const struct kmem_va_mode *kv,
     const struct kmem_pa_mode *kp, const struct kmem_dyn_mode *kd)
@@ -817,18 +909,31 @@ alloc_va:
 
 		if (kp->kp_object)
 			uobj = *kp->kp_object;
+
+		/*
+		 * Small dynamic allocations in kernel_map can usually
+		 * be satisfied from the local quantum cache without
+		 * taking the map lock.
+		 */
+		va = 0;
+		if (kv == &kv_any && uobj == NULL && !kp->kp_pageable &&
+		    kd->kd_prefer == UVM_UNKNOWN_OFFSET)
+			va = uvm_km_qget(sz);
+		if (va == 0) {
 try_map:
-		map = *kv->kv_map;
-		va = vm_map_min(map);
-		if (uvm_map(map, &va, sz, uobj, kd->kd_prefer,
-		    kv->kv_align, UVM_MAPFLAG(prot, prot, MAP_INHERIT_NONE,
-		    MADV_RANDOM, mapflags))) {
-			if (kv->kv_wait && kd->kd_waitok) {
-				tsleep_nsec(map, PVM, "km_allocva", INFSLP);
-				goto try_map;
+			map = *kv->kv_map;
+			va = vm_map_min(map);
+			if (uvm_map(map, &va, sz, uobj, kd->kd_prefer,
+			    kv->kv_align, UVM_MAPFLAG(prot, prot,
+			    MAP_INHERIT_NONE, MADV_RANDOM, mapflags))) {
+				if (kv->kv_wait && kd->kd_waitok) {
+					tsleep_nsec(map, PVM, "km_allocva",
+					    INFSLP);
+					goto try_map;
+				}
+				uvm_pglistfree(&pgl);
+				return (NULL);
 			}
-			uvm_pglistfree(&pgl);
-			return (NULL);
 		}
 	}
 	sva = va;
@@ -904,6 +1009,14 @@ km_free(void *v, size_t sz, const struct kmem_va_mode *kv,
 		uvm_pglistfree(&pgl);
 	}
 free_va:
+	/*
+	 * Park small kernel_map ranges on the local quantum cache
+	 * instead of unmapping them; the pages are gone already, so a
+	 * cached range only pins its VA and map entry.
+	 */
+	if (kv == &kv_any && !kp->kp_pageable && uvm_km_qput(sva, sz))
+		return;
+
 	uvm_unmap(*kv->kv_map, sva, eva);
 	if (kv->kv_wait)
 		wakeup(*kv->kv_map);
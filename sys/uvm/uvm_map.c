@@ -440,6 +440,8 @@ uvm_mapent_addr_remove(struct vm_map *map, struct vm_map_entry *entry)
 	    entry->start, entry->end, entry->protection, NULL);
 
 	UVM_MAP_REQ_WRITE(map);
+	if (map->hint == entry)
+		map->hint = NULL;
 	res = RBT_REMOVE(uvm_map_addr, &map->addr, entry);
 	if (res != entry)
 		panic("uvm_mapent_addr_remove");
@@ -1590,11 +1592,32 @@ boolean_t
 uvm_map_lookup_entry(struct vm_map *map, vaddr_t address,
     struct vm_map_entry **entry)
 {
+	struct vm_map_entry *hint;
+
 	vm_map_assert_anylock(map);
 
+	/*
+	 * Faults and syscalls tend to revisit the same entry, so check
+	 * the last successful lookup before descending into the tree.
+	 * Entries are only removed with the map write-locked, which
+	 * clears the hint, so with at least a read lock held the hint
+	 * cannot point at a freed entry.  Concurrent readers may store
+	 * competing hints; losing that race only costs the fast path.
+	 */
+	hint = map->hint;
+	if (hint != NULL && !UVM_ET_ISHOLE(hint) &&
+	    hint->start <= address && hint->end > address) {
+		*entry = hint;
+		return TRUE;
+	}
+
 	*entry = uvm_map_entrybyaddr(&map->addr, address);
-	return *entry != NULL && !UVM_ET_ISHOLE(*entry) &&
-	    (*entry)->start <= address && (*entry)->end > address;
+	if (*entry != NULL && !UVM_ET_ISHOLE(*entry) &&
+	    (*entry)->start <= address && (*entry)->end > address) {
+		map->hint = *entry;
+		return TRUE;
+	}
+	return FALSE;
 }
 
 /*
@@ -2467,6 +2490,7 @@ uvm_map_setup(struct vm_map *map, pmap_t pmap, vaddr_t min, vaddr_t max,
 	}
 
 	RBT_INIT(uvm_map_addr, &map->addr);
+	map->hint = NULL;
 	map->uaddr_exe = NULL;
 	for (i = 0; i < nitems(map->uaddr_any); ++i)
 		map->uaddr_any[i] = NULL;
@@ -264,6 +264,7 @@ struct vm_map {
 	u_long			wserial;	/* [v] # PROT_WRITE increases */
 
 	struct uvm_map_addr	addr;		/* [v] Entry tree, by addr */
+	struct vm_map_entry	*hint;		/* [v] Last successful lookup */
 
 	vsize_t			size;		/* virtual size */
 	int			ref_count;	/* [a] Reference count */
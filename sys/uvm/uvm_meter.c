@@ -159,6 +159,18 @@ uvm_sysctl(int *name, u_int namelen, void *oldp, size_t *oldlenp, void *newp,
 		uvmexp.vnodemin = t * 256 / 100;
 		return rv;
 
+	case VM_PDBATCH:
+		t = uvmpd_batchfactor;
+		rv = sysctl_int(oldp, oldlenp, newp, newlen, &t);
+		if (rv) {
+			return rv;
+		}
+		if (t < 1 || t > 64) {
+			return EINVAL;
+		}
+		uvmpd_batchfactor = t;
+		return rv;
+
 	case VM_MAXSLP:
 		return (sysctl_rdint(oldp, oldlenp, newp, maxslp));
 
@@ -197,6 +197,15 @@ uvmpd_tune(void)
  */
 volatile int uvm_nowait_failed;
 
+/*
+ * uvmpd_batchfactor: how many multiples of freetarg the inactive scan
+ * may have free or in flight before it stops queueing pageouts.  Larger
+ * values keep more asynchronous writeback outstanding, so reclaim
+ * bandwidth tracks the paging device instead of I/O round trips.
+ * Tunable via sysctl vm.pdbatch.
+ */
+int uvmpd_batchfactor = 4;
+
 /*
  * uvm_pageout: the main loop for the pagedaemon
  */
@@ -249,6 +258,9 @@ uvm_pageout(void *arg)
 		}
 		uvm_unlock_pageq();
 
+		/* Put the pages cached on this CPU back into circulation. */
+		uvm_pmr_cache_drain();
+
 		/* Reclaim pages from the buffer cache if possible. */
 		size = 0;
 		if (pma != NULL)
@@ -460,7 +472,8 @@ uvmpd_scan_inactive(struct uvm_pmalloc *pma,
 			 */
 			free = uvmexp.free - BUFPAGES_DEFICIT;
 			if (((pma == NULL || (pma->pm_flags & UVM_PMA_FREED)) &&
-			    (free + uvmexp.paging >= uvmexp.freetarg << 2)) ||
+			    (free + uvmexp.paging >=
+			    uvmexp.freetarg * uvmpd_batchfactor)) ||
 			    dirtyreacts == UVMPD_NUMDIRTYREACTS) {
 				if (swslot == 0) {
 					/* exit now if no swap-i/o pending */
@@ -1659,6 +1659,138 @@ uvm_pmr_allocpmr(void)
 	return nw;
 }
 
+/*
+ * Per-CPU magazines caching single free pages on top of the pmemrange
+ * allocator.  The common uvm_pagealloc()/uvm_pagefree() cycle is served
+ * from CPU-local state and only takes the fpageq lock when a whole
+ * magazine has to be refilled from or released to the allocator.
+ *
+ * Each cache is a pair of magazines; when the active one runs empty or
+ * full the pair is swapped, so a burst of allocations followed by a
+ * burst of frees does not thrash the allocator at the magazine size.
+ * The per-cache mutex only serializes against interrupts and the rare
+ * migration between reading the CPU number and taking the mutex, it is
+ * never contended across CPUs in the fast path.
+ */
+struct uvm_pmr_cache uvm_pmr_caches[MAXCPUS];
+
+int
+uvm_pmr_cache_magazine_refill(struct uvm_pmr_cache_item *upci, int flags)
+{
+	struct pglist pgl;
+	struct vm_page *pg;
+
+	KASSERT(upci->upci_npages == 0);
+
+	TAILQ_INIT(&pgl);
+	if (uvm_pmr_getpages(UVM_PMR_CACHEMAGSZ, 0, 0, 1, 0,
+	    UVM_PMR_CACHEMAGSZ, flags, &pgl) != 0)
+		return (ENOMEM);
+
+	while ((pg = TAILQ_FIRST(&pgl)) != NULL) {
+		TAILQ_REMOVE(&pgl, pg, pageq);
+		upci->upci_pages[upci->upci_npages++] = pg;
+	}
+
+	return (0);
+}
+
+void
+uvm_pmr_cache_magazine_release(struct uvm_pmr_cache_item *upci)
+{
+	struct pglist pgl;
+
+	TAILQ_INIT(&pgl);
+	while (upci->upci_npages > 0) {
+		TAILQ_INSERT_TAIL(&pgl,
+		    upci->upci_pages[--upci->upci_npages], pageq);
+	}
+	uvm_pmr_freepageq(&pgl);
+}
+
+/*
+ * Allocate a single page from the per-CPU cache.
+ *
+ * => caller may not sleep, flags must include UVM_PLA_NOWAIT
+ * => magazines hold unzeroed pages, UVM_PLA_ZERO is done at hand-out
+ */
+struct vm_page *
+uvm_pmr_cache_get(int flags)
+{
+	struct uvm_pmr_cache *upc;
+	struct uvm_pmr_cache_item *upci;
+	struct vm_page *pg;
+	struct pglist pgl;
+
+	KASSERT(ISSET(flags, UVM_PLA_NOWAIT));
+
+	upc = &uvm_pmr_caches[cpu_number()];
+	mtx_enter(&upc->upc_mtx);
+	upci = &upc->upc_magz[upc->upc_actv];
+	if (upci->upci_npages == 0) {
+		upc->upc_actv = !upc->upc_actv;
+		upci = &upc->upc_magz[upc->upc_actv];
+		if (upci->upci_npages == 0 &&
+		    uvm_pmr_cache_magazine_refill(upci,
+		    flags & ~UVM_PLA_ZERO) != 0) {
+			mtx_leave(&upc->upc_mtx);
+
+			/* Let a single page succeed where a batch fails. */
+			TAILQ_INIT(&pgl);
+			if (uvm_pmr_getpages(1, 0, 0, 1, 0, 1, flags,
+			    &pgl) != 0)
+				return (NULL);
+			return (TAILQ_FIRST(&pgl));
+		}
+	}
+	pg = upci->upci_pages[--upci->upci_npages];
+	mtx_leave(&upc->upc_mtx);
+
+	if (ISSET(flags, UVM_PLA_ZERO) && !ISSET(pg->pg_flags, PG_ZERO))
+		uvm_pagezero(pg);
+
+	return (pg);
+}
+
+/*
+ * Return a single page to the per-CPU cache.
+ */
+void
+uvm_pmr_cache_put(struct vm_page *pg)
+{
+	struct uvm_pmr_cache *upc;
+	struct uvm_pmr_cache_item *upci;
+
+	upc = &uvm_pmr_caches[cpu_number()];
+	mtx_enter(&upc->upc_mtx);
+	upci = &upc->upc_magz[upc->upc_actv];
+	if (upci->upci_npages == UVM_PMR_CACHEMAGSZ) {
+		upc->upc_actv = !upc->upc_actv;
+		upci = &upc->upc_magz[upc->upc_actv];
+		if (upci->upci_npages == UVM_PMR_CACHEMAGSZ)
+			uvm_pmr_cache_magazine_release(upci);
+	}
+	upci->upci_pages[upci->upci_npages++] = pg;
+	mtx_leave(&upc->upc_mtx);
+}
+
+/*
+ * Empty this CPU's caches back into the allocator.  Called by the page
+ * daemon on memory shortage; it can only reach its own CPU's magazines.
+ */
+void
+uvm_pmr_cache_drain(void)
+{
+	struct uvm_pmr_cache *upc;
+	int i;
+
+	upc = &uvm_pmr_caches[cpu_number()];
+	mtx_enter(&upc->upc_mtx);
+	for (i = 0; i < nitems(upc->upc_magz); i++)
+		uvm_pmr_cache_magazine_release(&upc->upc_magz[i]);
+	mtx_leave(&upc->upc_mtx);
+}
+
 /*
  * Initialization of pmr.
  * Called by uvm_page_init.
@@ -1671,6 +1803,9 @@ uvm_pmr_init(void)
 	struct uvm_pmemrange *new_pmr;
 	int i;
 
+	for (i = 0; i < MAXCPUS; i++)
+		mtx_init(&uvm_pmr_caches[i].upc_mtx, IPL_VM);
+
 	TAILQ_INIT(&uvm.pmr_control.use);
 	RBT_INIT(uvm_pmemrange_addr, &uvm.pmr_control.addr);
 	TAILQ_INIT(&uvm.pmr_control.allocs);
@@ -108,8 +108,29 @@ struct uvm_pmr_control {
 	TAILQ_HEAD(, uvm_pmalloc) allocs;
 };
 
+/*
+ * Per-CPU cache of single free pages, a pair of magazines per CPU.
+ */
+#define UVM_PMR_CACHEMAGSZ	16
+
+struct uvm_pmr_cache_item {
+	struct vm_page		*upci_pages[UVM_PMR_CACHEMAGSZ];
+	int			 upci_npages;
+};
+
+struct uvm_pmr_cache {
+	struct mutex		 upc_mtx;	/* serializes local access */
+	struct uvm_pmr_cache_item upc_magz[2];	/* magazine pair */
+	int			 upc_actv;	/* index of active magazine */
+} __aligned(64);
+
 void	uvm_pmr_freepages(struct vm_page *, psize_t);
 void	uvm_pmr_freepageq(struct pglist *);
+struct vm_page *uvm_pmr_cache_get(int);
+void	uvm_pmr_cache_put(struct vm_page *);
+void	uvm_pmr_cache_drain(void);
+int	uvm_pmr_cache_magazine_refill(struct uvm_pmr_cache_item *, int);
+void	uvm_pmr_cache_magazine_release(struct uvm_pmr_cache_item *);
 int	uvm_pmr_getpages(psize_t, paddr_t, paddr_t, paddr_t, paddr_t,
 	    int, int, struct pglist *);
 void	uvm_pmr_init(void);
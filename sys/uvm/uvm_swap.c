@@ -1679,6 +1679,52 @@ uvm_swap_get(struct vm_page *page, int swslot, int flags)
 	return (result);
 }
 
+/*
+ * uvm_swap_getpages: get a contiguous run of pages from swap
+ *
+ * => like uvm_swap_get, but fetches "npages" neighboring drum slots
+ *	with a single I/O; used for clustered swap readahead.
+ */
+int
+uvm_swap_getpages(struct vm_page **pgs, int startslot, int npages, int flags)
+{
+	int	result;
+
+	atomic_inc_int(&uvmexp.nswget);
+	KASSERT(flags & PGO_SYNCIO);
+	KASSERT(npages >= 1 && npages <= SWCLUSTPAGES);
+	KASSERT(startslot > 0);
+
+	KERNEL_LOCK();
+	result = uvm_swap_io(pgs, startslot, npages, B_READ);
+	KERNEL_UNLOCK();
+
+	if (result == VM_PAGER_OK || result == VM_PAGER_PEND) {
+		/*
+		 * these pages are no longer only in swap.
+		 */
+		atomic_add_int(&uvmexp.swpgonly, -npages);
+	}
+	return (result);
+}
+
+/*
+ * uvm_swap_samedev: check that a slot range lies within a single swap
+ * device, so that it can be transferred with one I/O operation.
+ */
+int
+uvm_swap_samedev(int startslot, int npages)
+{
+	struct swapdev *sdp, *esdp;
+
+	mtx_enter(&uvm_swap_data_lock);
+	sdp = swapdrum_getsdp(startslot);
+	esdp = swapdrum_getsdp(startslot + npages - 1);
+	mtx_leave(&uvm_swap_data_lock);
+
+	return (sdp != NULL && sdp == esdp);
+}
+
 /*
  * uvm_swap_io: do an i/o operation to swap
  */
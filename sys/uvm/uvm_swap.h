@@ -38,6 +38,8 @@
 #ifdef _KERNEL
 
 int			uvm_swap_get(struct vm_page *, int, int);
+int			uvm_swap_getpages(struct vm_page **, int, int, int);
+int			uvm_swap_samedev(int, int);
 int			uvm_swap_put(int, struct vm_page **, int, int);
 int			uvm_swap_alloc(int *, boolean_t);
 void			uvm_swap_free(int, int);
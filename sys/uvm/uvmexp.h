@@ -18,7 +18,8 @@
 #define	VM_MAXSLP	10
 #define	VM_USPACE	11
 #define	VM_MALLOC_CONF	12		/* config for userland malloc */
-#define	VM_MAXID	13		/* number of valid vm ids */
+#define	VM_PDBATCH	13		/* pagedaemon writeback batch factor */
+#define	VM_MAXID	14		/* number of valid vm ids */
 
 #define	CTL_VM_NAMES { \
 	{ 0, 0 }, \
@@ -34,6 +35,7 @@
 	{ "maxslp", CTLTYPE_INT }, \
 	{ "uspace", CTLTYPE_INT }, \
 	{ "malloc_conf", CTLTYPE_STRING }, \
+	{ "pdbatch", CTLTYPE_INT }, \
 }
 
 /*
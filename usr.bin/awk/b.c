@@ -196,6 +196,7 @@ fa *makedfa(const char *s, bool anchor)	/* returns dfa for reg expr s */
 	int i, use, nuse;
 	fa *pfa;
 	static int now = 1;
+	static int lastfa = -1;
 
 	if (setvec == NULL) {	/* first time through any RE */
 		allocsetvec(__func__);
@@ -203,16 +204,25 @@ fa *makedfa(const char *s, bool anchor)	/* returns dfa for reg expr s */
 
 	if (compile_time != RUNNING)	/* a constant for sure */
 		return mkdfa(s, anchor);
+	/* most lookups repeat the previous one, check it first */
+	if (lastfa >= 0 && lastfa < nfatab
+	  && fatab[lastfa]->anchor == anchor
+	  && strcmp((const char *) fatab[lastfa]->restr, s) == 0) {
+		fatab[lastfa]->use = now++;
+		return fatab[lastfa];
+	}
 	for (i = 0; i < nfatab; i++)	/* is it there already? */
 		if (fatab[i]->anchor == anchor
 		  && strcmp((const char *) fatab[i]->restr, s) == 0) {
 			fatab[i]->use = now++;
+			lastfa = i;
 			return fatab[i];
 		}
 	pfa = mkdfa(s, anchor);
 	if (nfatab < NFA) {	/* room for another */
 		fatab[nfatab] = pfa;
 		fatab[nfatab]->use = now++;
+		lastfa = nfatab;
 		nfatab++;
 		return pfa;
 	}
@@ -226,6 +236,7 @@ fa *makedfa(const char *s, bool anchor)	/* returns dfa for reg expr s */
 	freefa(fatab[nuse]);
 	fatab[nuse] = pfa;
 	pfa->use = now++;
+	lastfa = nuse;
 	return pfa;
 }
 
@@ -657,8 +668,8 @@ static int set_gototab(fa *f, int state, int ch, int val) /* hide gototab inplem
 		if (tab->inuse + 1 >= tab->allocated)
 			resize_gototab(f, state);
 
-		f->gototab[state].entries[f->gototab[state].inuse-1].ch = ch;
-		f->gototab[state].entries[f->gototab[state].inuse-1].state = val;
+		f->gototab[state].entries[f->gototab[state].inuse].ch = ch;
+		f->gototab[state].entries[f->gototab[state].inuse].state = val;
 		f->gototab[state].inuse++;
 		return val;
 	} else {
@@ -683,9 +694,9 @@ static int set_gototab(fa *f, int state, int ch, int val) /* hide gototab inplem
 	gtt *tab = & f->gototab[state];
 	if (tab->inuse + 1 >= tab->allocated)
 		resize_gototab(f, state);
-	++tab->inuse;
 	f->gototab[state].entries[tab->inuse].ch = ch;
 	f->gototab[state].entries[tab->inuse].state = val;
+	++tab->inuse;
 
 	qsort(f->gototab[state].entries,
 		f->gototab[state].inuse, sizeof(gtte), entry_cmp);
@@ -38,10 +38,11 @@ struct z_info {
 };
 
 /*
- * making it any bigger does not affect performance very much.
- * actually this value is just a little bit better than 8192.
+ * 64k quarters the number of read/write system calls made for large
+ * files compared to the old 16k value; beyond that the time is all
+ * spent in (in|de)flate and bigger buffers make no difference.
  */
-#define Z_BUFSIZE 16384
+#define Z_BUFSIZE 65536
 
 enum program_mode {
 	MODE_COMP,
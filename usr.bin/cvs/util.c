@@ -703,7 +703,7 @@ struct rcs_lines *
 cvs_splitlines(u_char *data, size_t len)
 {
 	u_char *p, *c;
-	size_t i, tlen;
+	size_t tlen;
 	struct rcs_lines *lines;
 	struct rcs_line *lp;
 
@@ -713,18 +713,19 @@ cvs_splitlines(u_char *data, size_t len)
 	lp = xcalloc(1, sizeof(*lp));
 	TAILQ_INSERT_TAIL(&(lines->l_lines), lp, l_list);
 
-	p = c = data;
-	for (i = 0; i < len; i++) {
-		if (*p == '\n' || (i == len - 1)) {
-			tlen = p - c + 1;
-			lp = xcalloc(1, sizeof(*lp));
-			lp->l_line = c;
-			lp->l_len = tlen;
-			lp->l_lineno = ++(lines->l_nblines);
-			TAILQ_INSERT_TAIL(&(lines->l_lines), lp, l_list);
-			c = p + 1;
-		}
-		p++;
+	p = data;
+	while (len > 0) {
+		if ((c = memchr(p, '\n', len)) != NULL)
+			tlen = c - p + 1;
+		else
+			tlen = len;
+		lp = xcalloc(1, sizeof(*lp));
+		lp->l_line = p;
+		lp->l_len = tlen;
+		lp->l_lineno = ++(lines->l_nblines);
+		TAILQ_INSERT_TAIL(&(lines->l_lines), lp, l_list);
+		p += tlen;
+		len -= tlen;
 	}
 
 	return (lines);
@@ -86,6 +86,8 @@
 #define MINIMUM(a, b)	(((a) < (b)) ? (a) : (b))
 #define MAXIMUM(a, b)	(((a) > (b)) ? (a) : (b))
 
+#define DIFFBUFSIZ	(64 * 1024)	/* stdio buffer for the input files */
+
 /*
  * diff - compare two files.
  */
@@ -352,6 +354,10 @@ diffreg(char *file1, char *file2, int flags)
 		goto closem;
 	}
 
+	/* the files are read several times, buffer them generously */
+	(void)setvbuf(f1, NULL, _IOFBF, DIFFBUFSIZ);
+	(void)setvbuf(f2, NULL, _IOFBF, DIFFBUFSIZ);
+
 	switch (files_differ(f1, f2, flags)) {
 	case 0:
 		goto closem;
@@ -423,7 +429,7 @@ closem:
 static int
 files_differ(FILE *f1, FILE *f2, int flags)
 {
-	char buf1[BUFSIZ], buf2[BUFSIZ];
+	static char buf1[DIFFBUFSIZ], buf2[DIFFBUFSIZ];
 	size_t i, j;
 
 	if ((flags & (D_EMPTY1|D_EMPTY2)) || stb1.st_size != stb2.st_size ||
@@ -450,7 +456,8 @@ files_differ(FILE *f1, FILE *f2, int flags)
 static FILE *
 opentemp(const char *file)
 {
-	char buf[BUFSIZ], tempfile[PATH_MAX];
+	static char buf[DIFFBUFSIZ];
+	char tempfile[PATH_MAX];
 	ssize_t nread;
 	int ifd, ofd;
 
@@ -466,7 +473,7 @@ opentemp(const char *file)
 		return (NULL);
 	}
 	unlink(tempfile);
-	while ((nread = read(ifd, buf, BUFSIZ)) > 0) {
+	while ((nread = read(ifd, buf, sizeof(buf))) > 0) {
 		if (write(ofd, buf, nread) != nread) {
 			close(ifd);
 			close(ofd);
@@ -993,7 +993,6 @@ static int
 magic_test_type_regex(struct magic_line *ml, struct magic_state *ms)
 {
 	const char	*cp;
-	regex_t		 re;
 	regmatch_t	 m;
 	int		 result, flags = 0, sflag = 0;
 
@@ -1016,12 +1015,24 @@ magic_test_type_regex(struct magic_line *ml, struct magic_state *ms)
 		}
 	}
 
-	if (regcomp(&re, ml->test_string, REG_EXTENDED|REG_NEWLINE|flags) != 0)
+	/*
+	 * Compile the regex once and keep it, the same line is tested
+	 * against every file given on the command line.
+	 */
+	if (ml->test_compiled == 0) {
+		if (regcomp(&ml->test_regex, ml->test_string,
+		    REG_EXTENDED|REG_NEWLINE|flags) != 0) {
+			ml->test_compiled = -1;
+			return (-1);
+		}
+		ml->test_compiled = 1;
+	}
+	if (ml->test_compiled == -1)
 		return (-1);
 	m.rm_so = ms->offset;
 	m.rm_eo = ms->size;
 
-	result = (regexec(&re, ms->base, 1, &m, REG_STARTEND) == 0);
+	result = (regexec(&ml->test_regex, ms->base, 1, &m, REG_STARTEND) == 0);
 	if (result == !ml->test_not) {
 		if (ml->result != NULL) {
 			magic_add_string(ms, ml, ms->base + m.rm_so,
@@ -1034,7 +1045,6 @@ magic_test_type_regex(struct magic_line *ml, struct magic_state *ms)
 				ms->offset = m.rm_eo;
 		}
 	}
-	regfree(&re);
 	return (result);
 }
 
@@ -136,6 +136,9 @@ struct magic_line {
 	int64_t			 test_signed;
 	double			 test_double;
 
+	int			 test_compiled;
+	regex_t			 test_regex;
+
 	int			 stringify;
 	const char		*result;
 	const char		*mimetype;
@@ -674,6 +674,10 @@ noslash:
 	fd = -1;
 #endif /* !NOSSL */
 
+	/* read the body through stdio in transfer buffer sized chunks */
+	if (fin != NULL)
+		(void)setvbuf(fin, NULL, _IOFBF, buflen);
+
 #ifdef SMALL
 	if (lastfile) {
 		if (pipeout) {
@@ -82,6 +82,10 @@ addarc(nltype *parentp, nltype *childp, long count)
 	 */
     arcp -> arc_parentlist = childp -> parents;
     childp -> parents = arcp;
+	/*
+	 *	enter it in the arc hash table
+	 */
+    archash( arcp );
 }
 
     /*
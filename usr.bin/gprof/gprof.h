@@ -80,6 +80,7 @@ struct arcstruct {
     struct arcstruct	*arc_parentlist; /* parents-of-this-child list */
     struct arcstruct	*arc_childlist;	/* children-of-this-parent list */
     struct arcstruct	*arc_next;	/* list of arcs on cycle */
+    struct arcstruct	*arc_hashlist;	/* arc hash bucket chain */
     unsigned short	arc_cyclecnt;	/* num cycles involved in */
     unsigned short	arc_flags;	/* see below */
 };
@@ -233,6 +234,7 @@ void		addarc(nltype *, nltype *, long);
 int		addcycle(arctype **, arctype **);
 void		addlist(struct stringlist *, char *);
 int		arccmp(arctype *, arctype *);
+void		archash(arctype *);
 arctype		*arclookup(nltype *, nltype *);
 void		asgnsamples(void);
 void		alignentries(void);
@@ -74,6 +74,56 @@ nllookup(unsigned long address)
     return 0;
 }
 
+    /*
+     *	the arcs are also entered in a hash table keyed by the
+     *	( parent , child ) pair, so that looking one up does not
+     *	have to walk the parent's whole list of children.
+     */
+static arctype	**archashtab;
+static long	archashsize;	/* number of buckets, a power of two */
+static long	archashcnt;	/* number of arcs entered */
+
+#define	ARCHASHINIT	1024
+
+#define	ARCHASH( parentp , childp ) \
+	( ( ( (unsigned long) (parentp) >> 4 ) ^ \
+	    ( (unsigned long) (childp) >> 2 ) ) & ( archashsize - 1 ) )
+
+void
+archash(arctype *arcp)
+{
+    arctype	**bucket;
+    arctype	**oldtab;
+    arctype	*oldp;
+    long	oldsize;
+    long	i;
+
+    if ( archashcnt >= 2 * archashsize ) {
+	oldtab = archashtab;
+	oldsize = archashsize;
+	archashsize = oldsize ? 2 * oldsize : ARCHASHINIT;
+	archashtab = calloc( archashsize , sizeof(arctype *) );
+	if ( archashtab == 0 ) {
+	    errx( 1 , "no room for %ld arc hash buckets" , archashsize );
+	}
+	for ( i = 0 ; i < oldsize ; i++ ) {
+	    while ( ( oldp = oldtab[ i ] ) != 0 ) {
+		oldtab[ i ] = oldp -> arc_hashlist;
+		bucket = &archashtab[
+		    ARCHASH( oldp -> arc_parentp , oldp -> arc_childp ) ];
+		oldp -> arc_hashlist = *bucket;
+		*bucket = oldp;
+	    }
+	}
+	free( oldtab );
+    }
+    bucket = &archashtab[ ARCHASH( arcp -> arc_parentp ,
+	arcp -> arc_childp ) ];
+    arcp -> arc_hashlist = *bucket;
+    *bucket = arcp;
+    archashcnt++;
+}
+
 arctype *
 arclookup(nltype *parentp, nltype *childp)
 {
@@ -89,7 +139,11 @@ arclookup(nltype *parentp, nltype *childp)
 		    parentp -> name , childp -> name );
 	}
 #   endif /* DEBUG */
-    for ( arcp = parentp -> children ; arcp ; arcp = arcp -> arc_childlist ) {
+    if ( archashtab == 0 ) {
+	return 0;
+    }
+    for ( arcp = archashtab[ ARCHASH( parentp , childp ) ] ; arcp ;
+	  arcp = arcp -> arc_hashlist ) {
 #	ifdef DEBUG
 	    if ( debug & LOOKUPDEBUG ) {
 		printf( "[arclookup]\t arc_parent %s arc_child %s\n" ,
@@ -97,7 +151,7 @@ arclookup(nltype *parentp, nltype *childp)
 			arcp -> arc_childp -> name );
 	    }
 #	endif /* DEBUG */
-	if ( arcp -> arc_childp == childp ) {
+	if ( arcp -> arc_parentp == parentp && arcp -> arc_childp == childp ) {
 	    return arcp;
 	}
     }
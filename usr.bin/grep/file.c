@@ -120,7 +120,8 @@ grep_fdopen(int fd)
 			return f;
 	}
 #endif
-	f->noseek = isatty(fd);
+	/* spare the isatty() syscall, a regular file cannot be a tty */
+	f->noseek = S_ISREG(sb.st_mode) ? 0 : isatty(fd);
 #ifndef SMALL
 	/* try mmap first; if it fails, try stdio */
 	if (!f->noseek && (f->mmf = mmopen(fd, &sb)) != NULL) {
@@ -32,6 +32,7 @@
 #include <err.h>
 #include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "grep.h"
@@ -78,9 +79,9 @@ mmfgetln(mmf_t *mmf, size_t *l)
 
 	if (mmf->ptr >= mmf->end)
 		return NULL;
-	for (p = mmf->ptr; mmf->ptr < mmf->end; ++mmf->ptr)
-		if (*mmf->ptr == '\n')
-		    break;
+	p = mmf->ptr;
+	if ((mmf->ptr = memchr(p, '\n', mmf->end - p)) == NULL)
+		mmf->ptr = mmf->end;
 
 	*l = mmf->ptr - p;
 	++mmf->ptr;
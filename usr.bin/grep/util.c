@@ -560,6 +560,21 @@ grep_search(fastgrep_t *fg, char *data, size_t dataLen, regmatch_t *pmatch,
 		/* Quick Search algorithm. */
 		j = 0;
 		do {
+			/*
+			 * A line position can only match if it starts with
+			 * the first pattern byte, let memchr(3) skip ahead
+			 * to the next candidate.
+			 */
+			if (!iflag && fg->patternLen > 0 &&
+			    fg->pattern[0] != '.') {
+				const char *q;
+
+				q = memchr(data + j, fg->pattern[0],
+				    dataLen - fg->patternLen - j + 1);
+				if (q == NULL)
+					break;
+				j = q - data;
+			}
 			if (grep_cmp(fg->pattern, data + j, fg->patternLen)) {
 				pmatch->rm_so = j;
 				pmatch->rm_eo = j + fg->patternLen;
@@ -629,6 +644,10 @@ grep_cmp(const char *pattern, const char *data, size_t len)
 {
 	size_t i;
 
+	/* Fixed strings without case folding compare as plain memory. */
+	if (Fflag && !iflag)
+		return memcmp(pattern, data, len) == 0;
+
 	for (i = 0; i < len; i++) {
 		if (((pattern[i] == data[i]) || (!Fflag && pattern[i] == '.'))
 		    || (iflag && pattern[i] == toupper((unsigned char)data[i])))
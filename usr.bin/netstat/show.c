@@ -114,6 +114,12 @@ get_sysctl(const int *mib, u_int mcnt, char **buf)
 			err(1, "sysctl-estimate");
 		if (needed == 0)
 			break;
+		/*
+		 * Leave room for the table to grow between the estimate
+		 * and the copy, otherwise a busy machine can keep us
+		 * restarting the dump indefinitely.
+		 */
+		needed += needed / 8;
 		if ((*buf = realloc(*buf, needed)) == NULL)
 			err(1, NULL);
 		if (sysctl(mib, mcnt, *buf, &needed, NULL, 0) == -1) {
@@ -33,26 +33,22 @@
 uint32_t
 hash_fast(const void *buf, size_t len)
 {
-	size_t			 i = 0;
-	uint32_t		 a = 0, /* part of a(k, l) */
+	size_t			 i;
+	uint32_t		 a = 0, /* a(k, l) */
 				 b = 0; /* b(k, l) */
 	const signed char	*dat = buf;
 
-	if (len > 4)
-		for ( ; i < len - 4; i += 4) {
-			b += 4 * (a + dat[i]) +
-			    3 * dat[i + 1] +
-			    2 * dat[i + 2] +
-			    dat[i + 3];
-			a += dat[i + 0] +
-			    dat[i + 1] +
-			    dat[i + 2] +
-			    dat[i + 3];
-		}
+	/*
+	 * The rolling formulation b += a carries a serial dependency
+	 * between iterations.  Expanding it, b(k, l) is the sum of
+	 * (len - i) * dat[i], which together with the plain byte sum
+	 * for a(k, l) gives two independent reductions the compiler
+	 * can vectorise.
+	 */
 
-	for ( ; i < len; i++) {
+	for (i = 0; i < len; i++) {
 		a += dat[i];
-		b += a;
+		b += (uint32_t)(len - i) * dat[i];
 	}
 
 	/* s(k, l) = (eps % M) + 2^16 b(k, l) % M */
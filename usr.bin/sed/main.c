@@ -335,8 +335,8 @@ int
 mf_fgets(SPACE *sp, enum e_spflag spflag)
 {
 	struct stat sb;
-	size_t len;
-	char dirbuf[PATH_MAX];
+	size_t len, tsize;
+	char dirbuf[PATH_MAX], *tp;
 	static char *p;
 	static size_t psize;
 	int c, fd;
@@ -438,7 +438,22 @@ mf_fgets(SPACE *sp, enum e_spflag spflag)
 	} else {
 		sp->append_newline = 0;
 	}
-	cspace(sp, p, len, spflag);
+	if (spflag == REPLACE && sp->space == sp->back) {
+		/*
+		 * The line replaces the space wholesale, so swap the
+		 * getline() buffer in instead of copying it; the old
+		 * backing memory is handed to getline() for reuse.
+		 */
+		tp = sp->back;
+		tsize = sp->blen;
+		sp->space = sp->back = p;
+		sp->blen = psize;
+		p = tp;
+		psize = tsize;
+		sp->len = len;
+		sp->space[len] = '\0';
+	} else
+		cspace(sp, p, len, spflag);
 
 	linenum++;
 
@@ -807,6 +807,7 @@ numcoll_impl(struct key_value *kv1, struct key_value *kv2,
 		if (main1 < 1 && frac1 < 1)
 			kv1->hint->v.nh.empty=true;
 		kv1->hint->v.nh.si = SI1;
+		kv1->hint->v.nh.no_frac = (frac1 == 0);
 		kv1->hint->status = (kv1->hint->v.nh.n1 != ULLONG_MAX) ?
 		    HS_INITIALIZED : HS_ERROR;
 		kv1->hint->v.nh.neg = (sign1 < 0) ? true : false;
@@ -820,6 +821,7 @@ numcoll_impl(struct key_value *kv1, struct key_value *kv2,
 		if (main2 < 1 && frac2 < 1)
 			kv2->hint->v.nh.empty=true;
 		kv2->hint->v.nh.si = SI2;
+		kv2->hint->v.nh.no_frac = (frac2 == 0);
 		kv2->hint->status = (kv2->hint->v.nh.n1 != ULLONG_MAX) ?
 		    HS_INITIALIZED : HS_ERROR;
 		kv2->hint->v.nh.neg = (sign2 < 0) ? true : false;
@@ -862,6 +864,13 @@ numcoll_impl(struct key_value *kv1, struct key_value *kv2,
 			return neg1 ? 1 : -1;
 		else if (n1 > n2)
 			return neg1 ? -1 : 1;
+
+		/*
+		 * The integer parts are equal.  Without fractions the
+		 * keys are equal, no need to parse the strings again.
+		 */
+		if (kv1->hint->v.nh.no_frac && kv2->hint->v.nh.no_frac)
+			return 0;
 	}
 
 	/* read the numbers from the strings */
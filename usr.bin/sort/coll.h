@@ -41,6 +41,7 @@ struct n_hint {
 	unsigned char		 si;
 	bool			 empty;
 	bool			 neg;
+	bool			 no_frac;
 };
 
 /*
@@ -58,7 +58,12 @@ size_t max_open_files = 16;
 /*
  * How much space we read from file at once
  */
-#define READ_CHUNK 4096
+#define READ_CHUNK (128 * 1024)
+
+/*
+ * stdio buffer size for files we write
+ */
+#define WRITE_BUF (256 * 1024)
 
 /*
  * File reader structure
@@ -488,6 +493,9 @@ openfile(const char *fn, const char *mode)
 	} else if ((file = fopen(fn, mode)) == NULL)
 		err(2, "%s", fn);
 
+	if (mode[0] == 'w')
+		(void)setvbuf(file, NULL, _IOFBF, WRITE_BUF);
+
 	return file;
 }
 
@@ -173,6 +173,13 @@ struct ssh_channels {
 	chan_fn **channel_pre;
 	chan_fn **channel_post;
 
+	/*
+	 * Offset at which channel_handler starts its walk over the channel
+	 * array, advanced every cycle so that no channel is always serviced
+	 * first when many are ready.
+	 */
+	u_int channel_rr_offset;
+
 	/* -- tcp forwarding */
 	struct permission_set local_perms;
 	struct permission_set remote_perms;
@@ -2562,12 +2569,21 @@ channel_handler(struct ssh *ssh, int table, struct timespec *timeout)
 {
 	struct ssh_channels *sc = ssh->chanctxt;
 	chan_fn **ftab = table == CHAN_PRE ? sc->channel_pre : sc->channel_post;
-	u_int i, oalloc;
+	u_int i, n, oalloc;
 	Channel *c;
 	time_t now;
 
+	/*
+	 * Walk the array round-robin starting at a rotating offset so a
+	 * busy low-numbered channel (e.g. a bulk transfer) cannot drain
+	 * shared output buffer space ahead of the others on every cycle.
+	 */
 	now = monotime();
-	for (i = 0, oalloc = sc->channels_alloc; i < oalloc; i++) {
+	oalloc = sc->channels_alloc;
+	if (table == CHAN_POST && oalloc != 0)
+		sc->channel_rr_offset = (sc->channel_rr_offset + 1) % oalloc;
+	for (n = 0; n < oalloc; n++) {
+		i = (sc->channel_rr_offset + n) % oalloc;
 		c = sc->channels[i];
 		if (c == NULL)
 			continue;
@@ -755,7 +755,7 @@ hostkeys_foreach_file(const char *path, FILE *f, hostkeys_foreach_fn *callback,
 {
 	char *line = NULL, ktype[128];
 	u_long linenum = 0;
-	char *cp, *cp2;
+	char *cp, *cp2, *hostsep, sep = '\0';
 	u_int kbits;
 	int hashed;
 	int s, r = 0;
@@ -773,9 +773,9 @@ hostkeys_foreach_file(const char *path, FILE *f, hostkeys_foreach_fn *callback,
 		free(lineinfo.line);
 		sshkey_free(lineinfo.key);
 		memset(&lineinfo, 0, sizeof(lineinfo));
+		hostsep = NULL;
 		lineinfo.path = path;
 		lineinfo.linenum = linenum;
-		lineinfo.line = xstrdup(line);
 		lineinfo.marker = MRK_NONE;
 		lineinfo.status = HKF_STATUS_OK;
 		lineinfo.keytype = KEY_UNSPEC;
@@ -787,6 +787,7 @@ hostkeys_foreach_file(const char *path, FILE *f, hostkeys_foreach_fn *callback,
 		if (!*cp || *cp == '#' || *cp == '\n') {
 			if ((options & HKF_WANT_MATCH) == 0) {
 				lineinfo.status = HKF_STATUS_COMMENT;
+				lineinfo.line = xstrdup(line);
 				if ((r = callback(&lineinfo, ctx)) != 0)
 					break;
 			}
@@ -804,6 +805,8 @@ hostkeys_foreach_file(const char *path, FILE *f, hostkeys_foreach_fn *callback,
 		for (cp2 = cp; *cp2 && *cp2 != ' ' && *cp2 != '\t'; cp2++)
 			;
 		lineinfo.hosts = cp;
+		hostsep = cp2;
+		sep = *cp2;
 		*cp2++ = '\0';
 
 		/* Check if the host name matches. */
@@ -905,11 +908,24 @@ hostkeys_foreach_file(const char *path, FILE *f, hostkeys_foreach_fn *callback,
 				sshkey_free(lineinfo.key);
 				lineinfo.key = NULL;
 				lineinfo.status = HKF_STATUS_INVALID;
+				lineinfo.line = xstrdup(line);
+				if (hostsep != NULL)
+					lineinfo.line[hostsep - line] = sep;
 				if ((r = callback(&lineinfo, ctx)) != 0)
 					break;
 				continue;
 			}
 		}
+		/*
+		 * Copying the line is delayed until a callback actually
+		 * gets it; with HKF_WANT_MATCH set almost every line of a
+		 * large file is skipped before this point.  Undo the NUL
+		 * written over the host/key separator above so the copy
+		 * matches the input.
+		 */
+		lineinfo.line = xstrdup(line);
+		if (hostsep != NULL)
+			lineinfo.line[hostsep - line] = sep;
 		if ((r = callback(&lineinfo, ctx)) != 0)
 			break;
 	}
@@ -1085,11 +1085,11 @@ ssh_packet_send2_wrapped(struct ssh *ssh)
 		/* skip header, compress only payload */
 		if ((r = sshbuf_consume(state->outgoing_packet, 5)) != 0)
 			goto out;
-		sshbuf_reset(state->compression_buffer);
+		sshbuf_reset_keepalloc(state->compression_buffer);
 		if ((r = compress_buffer(ssh, state->outgoing_packet,
 		    state->compression_buffer)) != 0)
 			goto out;
-		sshbuf_reset(state->outgoing_packet);
+		sshbuf_reset_keepalloc(state->outgoing_packet);
 		if ((r = sshbuf_put(state->outgoing_packet,
 		    "\0\0\0\0\0", 5)) != 0 ||
 		    (r = sshbuf_putb(state->outgoing_packet,
@@ -1199,7 +1199,7 @@ ssh_packet_send2_wrapped(struct ssh *ssh)
 			return SSH_ERR_NEED_REKEY;
 	state->p_send.blocks += len / block_size;
 	state->p_send.bytes += len;
-	sshbuf_reset(state->outgoing_packet);
+	sshbuf_reset_keepalloc(state->outgoing_packet);
 
 	if (type == SSH2_MSG_NEWKEYS && ssh->kex->kex_strict) {
 		debug_f("resetting send seqnr %u", state->p_send.seqnr);
@@ -1427,7 +1427,7 @@ ssh_packet_read_poll2_mux(struct ssh *ssh, u_char *typep, u_int32_t *seqnr_p)
 	need = state->packlen + 4;
 	if (sshbuf_len(state->input) < need)
 		return 0; /* packet is incomplete */
-	sshbuf_reset(state->incoming_packet);
+	sshbuf_reset_keepalloc(state->incoming_packet);
 	if ((r = sshbuf_put(state->incoming_packet, cp + 4,
 	    state->packlen)) != 0 ||
 	    (r = sshbuf_consume(state->input, need)) != 0 ||
@@ -1489,7 +1489,7 @@ ssh_packet_read_poll2(struct ssh *ssh, u_char *typep, u_int32_t *seqnr_p)
 				return r;
 			return SSH_ERR_CONN_CORRUPT;
 		}
-		sshbuf_reset(state->incoming_packet);
+		sshbuf_reset_keepalloc(state->incoming_packet);
 	} else if (state->packlen == 0) {
 		/*
 		 * check if input size is less than the cipher block size,
@@ -1497,7 +1497,7 @@ ssh_packet_read_poll2(struct ssh *ssh, u_char *typep, u_int32_t *seqnr_p)
 		 */
 		if (sshbuf_len(state->input) < block_size)
 			return 0;
-		sshbuf_reset(state->incoming_packet);
+		sshbuf_reset_keepalloc(state->incoming_packet);
 		if ((r = sshbuf_reserve(state->incoming_packet, block_size,
 		    &cp)) != 0)
 			goto out;
@@ -1629,11 +1629,11 @@ ssh_packet_read_poll2(struct ssh *ssh, u_char *typep, u_int32_t *seqnr_p)
 	DBG(debug("input: len before de-compress %zd",
 	    sshbuf_len(state->incoming_packet)));
 	if (comp && comp->enabled) {
-		sshbuf_reset(state->compression_buffer);
+		sshbuf_reset_keepalloc(state->compression_buffer);
 		if ((r = uncompress_buffer(ssh, state->incoming_packet,
 		    state->compression_buffer)) != 0)
 			goto out;
-		sshbuf_reset(state->incoming_packet);
+		sshbuf_reset_keepalloc(state->incoming_packet);
 		if ((r = sshbuf_putb(state->incoming_packet,
 		    state->compression_buffer)) != 0)
 			goto out;
@@ -2633,7 +2633,7 @@ sshpkt_start(struct ssh *ssh, u_char type)
 	DBG(debug("packet_start[%d]", type));
 	memset(buf, 0, sizeof(buf));
 	buf[sizeof(buf) - 1] = type;
-	sshbuf_reset(ssh->state->outgoing_packet);
+	sshbuf_reset_keepalloc(ssh->state->outgoing_packet);
 	return sshbuf_put(ssh->state->outgoing_packet, buf, sizeof(buf));
 }
 
@@ -2663,7 +2663,7 @@ ssh_packet_send_mux(struct ssh *ssh)
 			return r;
 		/* sshbuf_dump(state->output, stderr); */
 	}
-	sshbuf_reset(state->outgoing_packet);
+	sshbuf_reset_keepalloc(state->outgoing_packet);
 	return 0;
 }
 
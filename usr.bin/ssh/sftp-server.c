@@ -813,16 +813,10 @@ process_read(u_int32_t id)
 			fatal_f("realloc failed");
 		buflen = len;
 	}
-	if (lseek(fd, off, SEEK_SET) == -1) {
-		status = errno_to_portable(errno);
-		error_f("seek \"%.100s\": %s", handle_to_name(handle),
-		    strerror(errno));
-		goto out;
-	}
 	if (len == 0) {
 		/* weird, but not strictly disallowed */
 		ret = 0;
-	} else if ((ret = read(fd, buf, len)) == -1) {
+	} else if ((ret = pread(fd, buf, len, off)) == -1) {
 		status = errno_to_portable(errno);
 		error_f("read \"%.100s\": %s", handle_to_name(handle),
 		    strerror(errno));
@@ -860,25 +854,21 @@ process_write(u_int32_t id)
 	if (fd < 0)
 		status = SSH2_FX_FAILURE;
 	else {
-		if (!(handle_to_flags(handle) & O_APPEND) &&
-		    lseek(fd, off, SEEK_SET) == -1) {
-			status = errno_to_portable(errno);
-			error_f("seek \"%.100s\": %s", handle_to_name(handle),
-			    strerror(errno));
-		} else {
 /* XXX ATOMICIO ? */
+		if (handle_to_flags(handle) & O_APPEND)
 			ret = write(fd, data, len);
-			if (ret == -1) {
-				status = errno_to_portable(errno);
-				error_f("write \"%.100s\": %s",
-				    handle_to_name(handle), strerror(errno));
-			} else if ((size_t)ret == len) {
-				status = SSH2_FX_OK;
-				handle_update_write(handle, ret);
-			} else {
-				debug2_f("nothing at all written");
-				status = SSH2_FX_FAILURE;
-			}
+		else
+			ret = pwrite(fd, data, len, off);
+		if (ret == -1) {
+			status = errno_to_portable(errno);
+			error_f("write \"%.100s\": %s",
+			    handle_to_name(handle), strerror(errno));
+		} else if ((size_t)ret == len) {
+			status = SSH2_FX_OK;
+			handle_update_write(handle, ret);
+		} else {
+			debug2_f("nothing at all written");
+			status = SSH2_FX_FAILURE;
 		}
 	}
 	send_status(id, status);
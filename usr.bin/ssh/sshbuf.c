@@ -213,6 +213,20 @@ sshbuf_reset(struct sshbuf *buf)
 	explicit_bzero(buf->d, buf->alloc);
 }
 
+void
+sshbuf_reset_keepalloc(struct sshbuf *buf)
+{
+	if (buf->readonly || buf->refcount > 1) {
+		/* Nonsensical. Just make buffer appear empty */
+		buf->off = buf->size;
+		return;
+	}
+	if (sshbuf_check_sanity(buf) != 0)
+		return;
+	buf->off = buf->size = 0;
+	explicit_bzero(buf->d, buf->alloc);
+}
+
 size_t
 sshbuf_max_size(const struct sshbuf *buf)
 {
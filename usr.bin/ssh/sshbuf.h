@@ -79,6 +79,13 @@ void	sshbuf_free(struct sshbuf *buf);
  */
 void	sshbuf_reset(struct sshbuf *buf);
 
+/*
+ * As sshbuf_reset, but retain the current allocation.  Intended for
+ * buffers that are emptied and refilled to a similar size in a loop,
+ * where releasing the allocation would be immediately undone.
+ */
+void	sshbuf_reset_keepalloc(struct sshbuf *buf);
+
 /*
  * Return the maximum size of buf
  */
@@ -612,7 +612,7 @@ control_append_data(struct client *c, struct control_pane *cp, uint64_t age,
 {
 	u_char	*new_data;
 	size_t	 new_size;
-	u_int	 i;
+	u_int	 i, start;
 
 	if (message == NULL) {
 		message = evbuffer_new();
@@ -629,12 +629,18 @@ control_append_data(struct client *c, struct control_pane *cp, uint64_t age,
 	new_data = window_pane_get_new_data(wp, &cp->offset, &new_size);
 	if (new_size < size)
 		fatalx("not enough data: %zu < %zu", new_size, size);
+	/* Add runs of printable bytes wholesale, escapes are rare. */
+	start = 0;
 	for (i = 0; i < size; i++) {
-		if (new_data[i] < ' ' || new_data[i] == '\\')
-			evbuffer_add_printf(message, "\\%03o", new_data[i]);
-		else
-			evbuffer_add_printf(message, "%c", new_data[i]);
+		if (new_data[i] >= ' ' && new_data[i] != '\\')
+			continue;
+		if (i != start)
+			evbuffer_add(message, new_data + start, i - start);
+		evbuffer_add_printf(message, "\\%03o", new_data[i]);
+		start = i + 1;
 	}
+	if (i != start)
+		evbuffer_add(message, new_data + start, i - start);
 	window_pane_update_used_data(wp, &cp->offset, size);
 	return (message);
 }
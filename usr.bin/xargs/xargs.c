@@ -91,10 +91,8 @@ main(int argc, char *argv[])
 	 *
 	 *	 (ARG_MAX - 4K - LENGTH(utility + arguments)) / 2.
 	 *
-	 * We arbitrarily limit the number of arguments to 5000.  This is
-	 * allowed by POSIX.2 as long as the resulting minimum exec line is
-	 * at least LINE_MAX.  Realloc'ing as necessary is possible, but
-	 * probably not worthwhile.
+	 * The real limit is set once the exec line budget is known, below;
+	 * this is only a fallback.
 	 */
 	nargs = 5000;
 	if ((arg_max = sysconf(_SC_ARG_MAX)) == -1)
@@ -186,6 +184,16 @@ main(int argc, char *argv[])
 	if (replstr != NULL && *replstr == '\0')
 		errx(1, "replstr may not be empty");
 
+	/*
+	 * Unless -n asks for smaller batches, accept as many arguments as
+	 * can possibly fit in the exec line; each one takes at least two
+	 * bytes.  A fixed cap, as used previously, makes runs over many
+	 * short arguments exec far more often than the byte budget
+	 * requires.
+	 */
+	if (!nflag && nline / 2 > nargs)
+		nargs = (nline < arg_max ? nline : arg_max) / 2;
+
 	/*
 	 * Allocate pointers for the utility name, the utility arguments,
 	 * the maximum arguments to be read from stdin and the trailing
@@ -45,6 +45,7 @@ struct	buf {
  */
 struct	conn {
 	const char	  *newnonce; /* nonce authority */
+	char		  *nonce; /* replay nonce banked for next request */
 	char		  *kid; /* kid when account exists */
 	int		   fd; /* acctproc handle */
 	int		   dfd; /* dnsproc handle */
@@ -265,33 +266,48 @@ sreq(struct conn *c, const char *addr, int kid, const char *req, char **loc)
 	struct httphead	*h;
 	ssize_t		 ssz;
 	long		 code;
+	int		 banked, retry = 0;
 
-	if ((host = url2host(c->newnonce, &port, &path)) == NULL)
-		return -1;
+again:
+	/*
+	 * Every reply from the CA carries a Replay-Nonce header meant
+	 * for the next request (RFC 8555 section 6.5), so only ask the
+	 * newNonce resource when there is none banked.
+	 */
+	if (c->nonce != NULL) {
+		nonce = c->nonce;
+		c->nonce = NULL;
+		banked = 1;
+	} else {
+		banked = 0;
 
-	if ((ssz = urlresolve(c->dfd, host, src)) < 0) {
+		if ((host = url2host(c->newnonce, &port, &path)) == NULL)
+			return -1;
+
+		if ((ssz = urlresolve(c->dfd, host, src)) < 0) {
+			free(host);
+			free(path);
+			return -1;
+		}
+
+		g = http_get(src, (size_t)ssz, host, port, path, 1, NULL, 0);
 		free(host);
 		free(path);
-		return -1;
-	}
-
-	g = http_get(src, (size_t)ssz, host, port, path, 1, NULL, 0);
-	free(host);
-	free(path);
-	if (g == NULL)
-		return -1;
+		if (g == NULL)
+			return -1;
 
-	h = http_head_get("Replay-Nonce", g->head, g->headsz);
-	if (h == NULL) {
-		warnx("%s: no replay nonce", c->newnonce);
-		http_get_free(g);
-		return -1;
-	} else if ((nonce = strdup(h->val)) == NULL) {
-		warn("strdup");
+		h = http_head_get("Replay-Nonce", g->head, g->headsz);
+		if (h == NULL) {
+			warnx("%s: no replay nonce", c->newnonce);
+			http_get_free(g);
+			return -1;
+		} else if ((nonce = strdup(h->val)) == NULL) {
+			warn("strdup");
+			http_get_free(g);
+			return -1;
+		}
 		http_get_free(g);
-		return -1;
 	}
-	http_get_free(g);
 
 	/*
 	 * Send the url, nonce and request payload to the acctproc.
@@ -339,6 +355,23 @@ sreq(struct conn *c, const char *addr, int kid, const char *req, char **loc)
 	if (g == NULL)
 		return -1;
 
+	/* Bank the nonce that came along for the next request. */
+	h = http_head_get("Replay-Nonce", g->head, g->headsz);
+	if (h != NULL) {
+		free(c->nonce);
+		if ((c->nonce = strdup(h->val)) == NULL)
+			warn("strdup");
+	}
+
+	/*
+	 * A banked nonce may have expired on the server.  The
+	 * rejection carries a fresh nonce, so try again once.
+	 */
+	if (g->code == 400 && banked && retry++ == 0) {
+		http_get_free(g);
+		goto again;
+	}
+
 	/* Stuff response into parse buffer. */
 	code = g->code;
 
@@ -915,6 +948,7 @@ out:
 	free(cert);
 	free(url);
 	free(thumb);
+	free(c.nonce);
 	free(c.kid);
 	free(c.buf.buf);
 	if (chngs != NULL)
@@ -126,6 +126,7 @@
  * IMSG_XON message will be sent and the RDE will produce more messages again.
  */
 #define RDE_RUNNER_ROUNDS	100
+#define RDE_RUNNER_LOOPS	10
 #define SESS_MSG_HIGH_MARK	2000
 #define SESS_MSG_LOW_MARK	500
 #define CTL_MSG_HIGH_MARK	500
@@ -246,6 +247,11 @@ struct trie_head {
 	int			 match_default_v6;
 	size_t			 v4_cnt;
 	size_t			 v6_cnt;
+	uint64_t		 hit_cnt;
+	uint64_t		 miss_cnt;
+	/* first octet coverage maps to skip lookups on a sure miss */
+	uint8_t			 covered_v4[32];
+	uint8_t			 covered_v6[32];
 };
 
 struct rde_prefixset {
@@ -606,6 +612,7 @@ enum imsg_type {
 	IMSG_CTL_SHOW_INTERFACE,
 	IMSG_CTL_SHOW_RIB,
 	IMSG_CTL_SHOW_RIB_PREFIX,
+	IMSG_CTL_SHOW_RIB_MRT,
 	IMSG_CTL_SHOW_RIB_COMMUNITIES,
 	IMSG_CTL_SHOW_RIB_ATTR,
 	IMSG_CTL_SHOW_NETWORK,
@@ -849,6 +856,8 @@ struct ctl_show_set {
 	size_t			v4_cnt;
 	size_t			v6_cnt;
 	size_t			as_cnt;
+	uint64_t		hit_cnt;
+	uint64_t		miss_cnt;
 	enum {
 		ASNUM_SET,
 		PREFIX_SET,
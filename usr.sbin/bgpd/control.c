@@ -285,6 +285,7 @@ control_dispatch_msg(struct pollfd *pfd, struct peer_head *peers)
 			case IMSG_CTL_SHOW_FLOWSPEC:
 			case IMSG_CTL_SHOW_RIB:
 			case IMSG_CTL_SHOW_RIB_PREFIX:
+			case IMSG_CTL_SHOW_RIB_MRT:
 			case IMSG_CTL_SHOW_SET:
 			case IMSG_CTL_SHOW_RTR:
 				break;
@@ -465,6 +466,7 @@ control_dispatch_msg(struct pollfd *pfd, struct peer_head *peers)
 			break;
 		case IMSG_CTL_SHOW_RIB:
 		case IMSG_CTL_SHOW_RIB_PREFIX:
+		case IMSG_CTL_SHOW_RIB_MRT:
 			if (imsg_get_data(&imsg, &ribreq, sizeof(ribreq)) ==
 			    -1) {
 				log_warnx("got IMSG_CTL_SHOW_RIB with "
@@ -133,6 +133,7 @@ extern struct rde_peer	*peerself;
 struct rde_dump_ctx {
 	LIST_ENTRY(rde_dump_ctx)	entry;
 	struct ctl_show_rib_request	req;
+	struct mrt			mrt;
 	uint32_t			peerid;
 	uint8_t				throttled;
 };
@@ -166,7 +167,7 @@ rde_main(int debug, int verbose)
 	struct rde_mrt_ctx	*mctx, *xmctx;
 	void			*newp;
 	u_int			 pfd_elms = 0, i, j;
-	int			 timeout;
+	int			 timeout, nready, rounds;
 	uint8_t			 aid;
 
 	log_init(debug, LOG_DAEMON);
@@ -261,7 +262,7 @@ rde_main(int debug, int verbose)
 		    nexthop_pending() || rib_dump_pending())
 			timeout = 0;
 
-		if (poll(pfd, i, timeout) == -1) {
+		if ((nready = poll(pfd, i, timeout)) == -1) {
 			if (errno == EINTR)
 				continue;
 			fatal("poll error");
@@ -306,8 +307,18 @@ rde_main(int debug, int verbose)
 		}
 
 		peer_foreach(rde_dispatch_imsg_peer, NULL);
-		rib_dump_runner();
-		nexthop_runner();
+		/*
+		 * If no fd was ready the only work left is the background
+		 * rib and nexthop runners.  Run multiple rounds of them
+		 * before going back to poll to amortize the fixed cost of
+		 * a loop iteration while converging.
+		 */
+		rounds = (nready == 0) ? RDE_RUNNER_LOOPS : 1;
+		do {
+			rib_dump_runner();
+			nexthop_runner();
+		} while (--rounds > 0 &&
+		    (rib_dump_pending() || nexthop_pending()));
 		if (ibuf_se && ibuf_se->w.queued < SESS_MSG_HIGH_MARK) {
 			for (aid = AID_MIN; aid < AID_MAX; aid++)
 				rde_update_queue_runner(aid);
@@ -670,6 +681,7 @@ badnetdel:
 		case IMSG_CTL_SHOW_NETWORK:
 		case IMSG_CTL_SHOW_RIB:
 		case IMSG_CTL_SHOW_RIB_PREFIX:
+		case IMSG_CTL_SHOW_RIB_MRT:
 			if (imsg_get_data(&imsg, &req, sizeof(req)) == -1) {
 				log_warnx("rde_dispatch: wrong imsg len");
 				break;
@@ -706,6 +718,8 @@ badnetdel:
 			cset.lastchange = pset->lastchange;
 			cset.v4_cnt = pset->th.v4_cnt;
 			cset.v6_cnt = pset->th.v6_cnt;
+			cset.hit_cnt = pset->th.hit_cnt;
+			cset.miss_cnt = pset->th.miss_cnt;
 			imsg_compose(ibuf_se_ctl, IMSG_CTL_SHOW_SET, 0,
 			    pid, -1, &cset, sizeof(cset));
 
@@ -735,6 +749,8 @@ badnetdel:
 				cset.lastchange = pset->lastchange;
 				cset.v4_cnt = pset->th.v4_cnt;
 				cset.v6_cnt = pset->th.v6_cnt;
+				cset.hit_cnt = pset->th.hit_cnt;
+				cset.miss_cnt = pset->th.miss_cnt;
 				imsg_compose(ibuf_se_ctl, IMSG_CTL_SHOW_SET, 0,
 				    pid, -1, &cset, sizeof(cset));
 			}
@@ -746,6 +762,8 @@ badnetdel:
 				cset.lastchange = pset->lastchange;
 				cset.v4_cnt = pset->th.v4_cnt;
 				cset.v6_cnt = pset->th.v6_cnt;
+				cset.hit_cnt = pset->th.hit_cnt;
+				cset.miss_cnt = pset->th.miss_cnt;
 				imsg_compose(ibuf_se_ctl, IMSG_CTL_SHOW_SET, 0,
 				    pid, -1, &cset, sizeof(cset));
 			}
@@ -2895,6 +2913,34 @@ rde_dump_upcall(struct rib_entry *re, void *ptr)
 		rde_dump_filter(p, &ctx->req, 0);
 }
 
+/* forward the MRT records queued by the mrt.c encoders to the client */
+static void
+rde_dump_mrt_send(struct rde_dump_ctx *ctx)
+{
+	struct ibuf		*buf;
+
+	while ((buf = TAILQ_FIRST(&ctx->mrt.wbuf.bufs)) != NULL) {
+		TAILQ_REMOVE(&ctx->mrt.wbuf.bufs, buf, entry);
+		ctx->mrt.wbuf.queued--;
+		if (imsg_compose_ibuf(ibuf_se_ctl, IMSG_CTL_SHOW_RIB_MRT,
+		    0, ctx->req.pid, buf) == -1) {
+			log_warn("%s: imsg_compose_ibuf", __func__);
+			return;
+		}
+	}
+}
+
+static void
+rde_dump_mrt_upcall(struct rib_entry *re, void *ptr)
+{
+	struct rde_dump_ctx	*ctx = ptr;
+
+	if (re == NULL)
+		return;
+	mrt_dump_upcall(re, &ctx->mrt);
+	rde_dump_mrt_send(ctx);
+}
+
 static void
 rde_dump_adjout_upcall(struct prefix *p, void *ptr)
 {
@@ -2985,6 +3031,16 @@ rde_dump_ctx_new(struct ctl_show_rib_request *req, pid_t pid,
 	ctx->req.pid = pid;
 	ctx->req.type = type;
 
+	if (type == IMSG_CTL_SHOW_RIB_MRT &&
+	    (req->flags & (F_CTL_ADJ_IN | F_CTL_ADJ_OUT | F_CTL_INVALID))) {
+		/* MRT dumps are only supported for full RIBs */
+		error = CTL_RES_PARSE_ERROR;
+		imsg_compose(ibuf_se_ctl, IMSG_CTL_RESULT, 0, pid, -1, &error,
+		    sizeof(error));
+		free(ctx);
+		return;
+	}
+
 	if (req->flags & (F_CTL_ADJ_IN | F_CTL_INVALID)) {
 		rid = RIB_ADJ_IN;
 	} else if (req->flags & F_CTL_ADJ_OUT) {
@@ -3089,6 +3145,17 @@ rde_dump_ctx_new(struct ctl_show_rib_request *req, pid_t pid,
 		    rde_dump_upcall, rde_dump_done, rde_dump_throttled) == -1)
 			goto nomem;
 		break;
+	case IMSG_CTL_SHOW_RIB_MRT:
+		ctx->mrt.type = MRT_TABLE_DUMP_V2;
+		ctx->mrt.wbuf.fd = -1;
+		TAILQ_INIT(&ctx->mrt.wbuf.bufs);
+		mrt_dump_v2_hdr(&ctx->mrt, conf);
+		rde_dump_mrt_send(ctx);
+		if (rib_dump_new(rid, ctx->req.aid, CTL_MSG_HIGH_MARK, ctx,
+		    rde_dump_mrt_upcall, rde_dump_done,
+		    rde_dump_throttled) == -1)
+			goto nomem;
+		break;
 	case IMSG_CTL_SHOW_RIB_PREFIX:
 		if (req->flags & F_LONGER) {
 			if (rib_dump_subtree(rid, &req->prefix, req->prefixlen,
@@ -3683,7 +3750,7 @@ rde_reload_done(void)
 			free(p);
 			peer->reconf_out = 1;
 		}
-		filterlist_free(fh);
+		peer_out_rules_put(fh);
 	}
 
 	/* bring ribs in sync */
@@ -4627,6 +4694,7 @@ rde_shutdown(void)
 	rib_shutdown();
 	nexthop_shutdown();
 	path_shutdown();
+	aspath_shutdown();
 	attr_shutdown();
 	pt_shutdown();
 	peer_shutdown();
@@ -120,6 +120,8 @@ struct rde_aspa_state {
 #define ASPATH_HEADER_SIZE	(offsetof(struct aspath, data))
 
 struct aspath {
+	RB_ENTRY(aspath)	entry;
+	int			refcnt;	/* reference count */
 	uint32_t		source_as;	/* cached source_as */
 	uint16_t		len;	/* total length of aspath in octets */
 	uint16_t		ascnt;	/* number of AS hops in data */
@@ -362,6 +364,7 @@ struct rde_peer *peer_match(struct ctl_neighbor *, uint32_t);
 struct rde_peer	*peer_add(uint32_t, struct peer_config *, struct filter_head *);
 struct filter_head	*peer_apply_out_filter(struct rde_peer *,
 			    struct filter_head *);
+void		 peer_out_rules_put(struct filter_head *);
 
 void		 rde_generate_updates(struct rib_entry *, struct prefix *,
 		    struct prefix *, enum eval_mode);
@@ -397,6 +400,7 @@ void		 attr_free(struct rde_aspath *, struct attr *);
 struct aspath	*aspath_get(void *, uint16_t);
 struct aspath	*aspath_copy(struct aspath *);
 void		 aspath_put(struct aspath *);
+void		 aspath_shutdown(void);
 u_char		*aspath_deflate(u_char *, uint16_t *, int *);
 void		 aspath_merge(struct rde_aspath *, struct attr *);
 uint32_t	 aspath_neighbor(struct aspath *);
@@ -325,6 +325,16 @@ static uint16_t aspath_countlength(struct aspath *, uint16_t, int);
 static void	 aspath_countcopy(struct aspath *, uint16_t, uint8_t *,
 		    uint16_t, int);
 
+RB_HEAD(aspath_tree, aspath)	aspathtable = RB_INITIALIZER(&aspathtable);
+RB_GENERATE_STATIC(aspath_tree, aspath, entry, aspath_compare);
+
+void
+aspath_shutdown(void)
+{
+	if (!RB_EMPTY(&aspathtable))
+		log_warnx("%s: free non-free table", __func__);
+}
+
 int
 aspath_compare(struct aspath *a1, struct aspath *a2)
 {
@@ -345,38 +355,36 @@ aspath_compare(struct aspath *a1, struct aspath *a2)
 struct aspath *
 aspath_get(void *data, uint16_t len)
 {
-	struct aspath		*aspath;
+	struct aspath		*aspath, *t;
 
 	aspath = malloc(ASPATH_HEADER_SIZE + len);
 	if (aspath == NULL)
 		fatal("%s", __func__);
 
-	rdemem.aspath_cnt++;
-	rdemem.aspath_size += ASPATH_HEADER_SIZE + len;
-
+	memset(aspath, 0, ASPATH_HEADER_SIZE);
 	aspath->len = len;
 	aspath->ascnt = aspath_count(data, len);
 	aspath->source_as = aspath_extract_origin(data, len);
 	memcpy(aspath->data, data, len);
 
+	if ((t = RB_INSERT(aspath_tree, &aspathtable, aspath)) != NULL) {
+		/* aspath already interned, use that one */
+		free(aspath);
+		aspath = t;
+	} else {
+		rdemem.aspath_cnt++;
+		rdemem.aspath_size += ASPATH_HEADER_SIZE + len;
+	}
+	aspath->refcnt++;
+
 	return (aspath);
 }
 
 struct aspath *
 aspath_copy(struct aspath *a)
 {
-	struct aspath		*aspath;
-
-	aspath = malloc(ASPATH_HEADER_SIZE + a->len);
-	if (aspath == NULL)
-		fatal("%s", __func__);
-
-	rdemem.aspath_cnt++;
-	rdemem.aspath_size += ASPATH_HEADER_SIZE + a->len;
-
-	memcpy(aspath, a,  ASPATH_HEADER_SIZE + a->len);
-
-	return (aspath);
+	a->refcnt++;
+	return (a);
 }
 
 void
@@ -385,6 +393,12 @@ aspath_put(struct aspath *aspath)
 	if (aspath == NULL)
 		return;
 
+	if (--aspath->refcnt > 0)
+		/* somebody still holds a reference */
+		return;
+
+	RB_REMOVE(aspath_tree, &aspathtable, aspath);
+
 	rdemem.aspath_cnt--;
 	rdemem.aspath_size -= ASPATH_HEADER_SIZE + aspath->len;
 	free(aspath);
@@ -391,19 +391,26 @@ rde_filter_equal(struct filter_head *a, struct filter_head *b)
 		fb->match.as.aset = asb;
 		if (r != 0)
 			return (0);
-		if (fa->match.prefixset.ps != NULL &&
+		/*
+		 * If both rules reference the very same set object its
+		 * dirty state cannot make them differ from each other.
+		 */
+		if (fa->match.prefixset.ps != fb->match.prefixset.ps &&
+		    fa->match.prefixset.ps != NULL &&
 		    fa->match.prefixset.ps->dirty) {
 			log_debug("%s: prefixset %s has changed",
 			    __func__, fa->match.prefixset.name);
 			return (0);
 		}
-		if (fa->match.originset.ps != NULL &&
+		if (fa->match.originset.ps != fb->match.originset.ps &&
+		    fa->match.originset.ps != NULL &&
 		    fa->match.originset.ps->dirty) {
 			log_debug("%s: originset %s has changed",
 			    __func__, fa->match.originset.name);
 			return (0);
 		}
 		if ((fa->match.as.flags & AS_FLAG_AS_SET) &&
+		    fa->match.as.aset != fb->match.as.aset &&
 		    fa->match.as.aset->dirty) {
 			log_debug("%s: as-set %s has changed",
 			    __func__, fa->match.as.name);
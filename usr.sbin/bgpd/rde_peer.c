@@ -38,6 +38,66 @@ struct iq {
 	struct imsg		imsg;
 };
 
+/*
+ * Peers with equal outbound filter sets share one copy of the rules.
+ * With large peer groups this collapses hundreds of identical rule
+ * lists into a handful of shared, reference counted heads.
+ */
+struct out_rules_ref {
+	LIST_ENTRY(out_rules_ref)	 entry;
+	struct filter_head		*rules;
+	int				 refcnt;
+};
+static LIST_HEAD(, out_rules_ref) out_rules_shared =
+    LIST_HEAD_INITIALIZER(out_rules_shared);
+
+/*
+ * Like rde_filter_equal() but additionally require that both rule sets
+ * reference the same prefixset, originset and as-set objects so that a
+ * shared head can never outlive a set one of its rules points to.
+ */
+static int
+out_rules_shareable(struct filter_head *a, struct filter_head *b)
+{
+	struct filter_rule	*fa, *fb;
+
+	if (!rde_filter_equal(a, b))
+		return (0);
+
+	fa = TAILQ_FIRST(a);
+	fb = TAILQ_FIRST(b);
+	while (fa != NULL && fb != NULL) {
+		if (fa->match.prefixset.ps != fb->match.prefixset.ps ||
+		    fa->match.originset.ps != fb->match.originset.ps ||
+		    fa->match.as.aset != fb->match.as.aset)
+			return (0);
+		fa = TAILQ_NEXT(fa, entry);
+		fb = TAILQ_NEXT(fb, entry);
+	}
+	return (1);
+}
+
+/* release a reference to a shared outbound filter head */
+void
+peer_out_rules_put(struct filter_head *rules)
+{
+	struct out_rules_ref	*r;
+
+	if (rules == NULL)
+		return;
+	LIST_FOREACH(r, &out_rules_shared, entry) {
+		if (r->rules == rules) {
+			if (--r->refcnt == 0) {
+				LIST_REMOVE(r, entry);
+				filterlist_free(r->rules);
+				free(r);
+			}
+			return;
+		}
+	}
+	fatalx("%s: unknown filter head", __func__);
+}
+
 int
 peer_has_as4byte(struct rde_peer *peer)
 {
@@ -187,13 +247,14 @@ peer_add(uint32_t id, struct peer_config *p_conf, struct filter_head *rules)
 struct filter_head *
 peer_apply_out_filter(struct rde_peer *peer, struct filter_head *rules)
 {
-	struct filter_head *old;
+	struct filter_head *old, *fh;
 	struct filter_rule *fr, *new;
+	struct out_rules_ref *r;
 
 	old = peer->out_rules;
-	if ((peer->out_rules = malloc(sizeof(*peer->out_rules))) == NULL)
+	if ((fh = malloc(sizeof(*fh))) == NULL)
 		fatal(NULL);
-	TAILQ_INIT(peer->out_rules);
+	TAILQ_INIT(fh);
 
 	TAILQ_FOREACH(fr, rules, entry) {
 		if (rde_filter_skip_rule(peer, fr))
@@ -204,9 +265,26 @@ peer_apply_out_filter(struct rde_peer *peer, struct filter_head *rules)
 		memcpy(new, fr, sizeof(*new));
 		filterset_copy(&fr->set, &new->set);
 
-		TAILQ_INSERT_TAIL(peer->out_rules, new, entry);
+		TAILQ_INSERT_TAIL(fh, new, entry);
+	}
+
+	/* use an existing shared head if an equal one is around */
+	LIST_FOREACH(r, &out_rules_shared, entry) {
+		if (out_rules_shareable(r->rules, fh)) {
+			filterlist_free(fh);
+			r->refcnt++;
+			peer->out_rules = r->rules;
+			return old;
+		}
 	}
 
+	if ((r = malloc(sizeof(*r))) == NULL)
+		fatal(NULL);
+	r->rules = fh;
+	r->refcnt = 1;
+	LIST_INSERT_HEAD(&out_rules_shared, r, entry);
+	peer->out_rules = fh;
+
 	return old;
 }
 
@@ -474,7 +552,7 @@ peer_down(struct rde_peer *peer, void *bula)
 	peer->stats.prefix_out_cnt = 0;
 
 	/* free filters */
-	filterlist_free(peer->out_rules);
+	peer_out_rules_put(peer->out_rules);
 
 	RB_REMOVE(peer_tree, &peertable, peer);
 	free(peer);
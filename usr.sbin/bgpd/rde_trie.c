@@ -141,6 +141,33 @@ inet6setbit(struct in6_addr *addr, uint8_t bit)
 	addr->s6_addr[bit / 8] |= (0x80 >> (bit % 8));
 }
 
+/*
+ * Mark all first octet values covered by prefix "first/plen" in the
+ * coverage map.  An entry can only cover a lookup if the first octet
+ * of the lookup falls into the entry's range, so an unset bit proves
+ * a miss without walking the trie.
+ */
+static void
+trie_covered_set(uint8_t *covered, uint8_t first, uint8_t plen)
+{
+	uint32_t i, n;
+
+	if (plen >= 8) {
+		covered[first / 8] |= 1 << (first % 8);
+		return;
+	}
+	n = 1U << (8 - plen);
+	first &= ~(n - 1);
+	for (i = 0; i < n; i++)
+		covered[(first + i) / 8] |= 1 << ((first + i) % 8);
+}
+
+static int
+trie_covered(const uint8_t *covered, uint8_t first)
+{
+	return covered[first / 8] & (1 << (first % 8));
+}
+
 static struct tentry_v4 *
 trie_add_v4(struct trie_head *th, struct in_addr *prefix, uint8_t plen)
 {
@@ -358,6 +385,8 @@ trie_add(struct trie_head *th, struct bgpd_addr *prefix, uint8_t plen,
 		 */
 		for (i = min; i <= max; i++)
 			inet4setbit(&n4->plenmask, i - 1);
+		trie_covered_set(th->covered_v4,
+		    ntohl(prefix->v4.s_addr) >> 24, plen);
 		break;
 	case AID_INET6:
 		if (max > 128)
@@ -370,6 +399,7 @@ trie_add(struct trie_head *th, struct bgpd_addr *prefix, uint8_t plen,
 		/* See above for the - 1 reason. */
 		for (i = min; i <= max; i++)
 			inet6setbit(&n6->plenmask, i - 1);
+		trie_covered_set(th->covered_v6, prefix->v6.s6_addr[0], plen);
 		break;
 	}
 	return 0;
@@ -401,6 +431,8 @@ trie_roa_add(struct trie_head *th, struct roa *roa)
 		n4 = trie_add_v4(th, &roa->prefix.inet, roa->prefixlen);
 		if (n4 == NULL)
 			return -1;
+		trie_covered_set(th->covered_v4,
+		    ntohl(roa->prefix.inet.s_addr) >> 24, roa->prefixlen);
 		stp = &n4->set;
 		break;
 	case AID_INET6:
@@ -410,6 +442,8 @@ trie_roa_add(struct trie_head *th, struct roa *roa)
 		n6 = trie_add_v6(th, &roa->prefix.inet6, roa->prefixlen);
 		if (n6 == NULL)
 			return -1;
+		trie_covered_set(th->covered_v6, roa->prefix.inet6.s6_addr[0],
+		    roa->prefixlen);
 		stp = &n6->set;
 		break;
 	default:
@@ -482,6 +516,10 @@ trie_match_v4(struct trie_head *th, struct in_addr *prefix, uint8_t plen,
 		return th->match_default_v4;
 	}
 
+	/* no entry covers this first octet, no match possible */
+	if (!trie_covered(th->covered_v4, ntohl(prefix->s_addr) >> 24))
+		return 0;
+
 	n = th->root_v4;
 	while (n) {
 		struct in_addr mp;
@@ -523,6 +561,10 @@ trie_match_v6(struct trie_head *th, struct in6_addr *prefix, uint8_t plen,
 		return th->match_default_v6;
 	}
 
+	/* no entry covers this first octet, no match possible */
+	if (!trie_covered(th->covered_v6, prefix->s6_addr[0]))
+		return 0;
+
 	n = th->root_v6;
 	while (n) {
 		struct in6_addr mp;
@@ -557,15 +599,25 @@ int
 trie_match(struct trie_head *th, struct bgpd_addr *prefix, uint8_t plen,
     int orlonger)
 {
+	int r;
+
 	switch (prefix->aid) {
 	case AID_INET:
-		return trie_match_v4(th, &prefix->v4, plen, orlonger);
+		r = trie_match_v4(th, &prefix->v4, plen, orlonger);
+		break;
 	case AID_INET6:
-		return trie_match_v6(th, &prefix->v6, plen, orlonger);
+		r = trie_match_v6(th, &prefix->v6, plen, orlonger);
+		break;
 	default:
 		/* anything else is no match */
 		return 0;
 	}
+
+	if (r)
+		th->hit_cnt++;
+	else
+		th->miss_cnt++;
+	return r;
 }
 
 static int
@@ -578,6 +630,10 @@ trie_roa_check_v4(struct trie_head *th, struct in_addr *prefix, uint8_t plen,
 
 	/* ignore possible default route since it does not make sense */
 
+	/* no entry covers this first octet, no match possible */
+	if (!trie_covered(th->covered_v4, ntohl(prefix->s_addr) >> 24))
+		return ROA_NOTFOUND;
+
 	n = th->root_v4;
 	while (n) {
 		struct in_addr mp;
@@ -626,6 +682,10 @@ trie_roa_check_v6(struct trie_head *th, struct in6_addr *prefix, uint8_t plen,
 
 	/* ignore possible default route since it does not make sense */
 
+	/* no entry covers this first octet, no match possible */
+	if (!trie_covered(th->covered_v6, prefix->s6_addr[0]))
+		return ROA_NOTFOUND;
+
 	n = th->root_v6;
 	while (n) {
 		struct in6_addr mp;
@@ -674,16 +734,26 @@ int
 trie_roa_check(struct trie_head *th, struct bgpd_addr *prefix, uint8_t plen,
     uint32_t as)
 {
+	int validity;
+
 	/* valid, invalid, unknown */
 	switch (prefix->aid) {
 	case AID_INET:
-		return trie_roa_check_v4(th, &prefix->v4, plen, as);
+		validity = trie_roa_check_v4(th, &prefix->v4, plen, as);
+		break;
 	case AID_INET6:
-		return trie_roa_check_v6(th, &prefix->v6, plen, as);
+		validity = trie_roa_check_v6(th, &prefix->v6, plen, as);
+		break;
 	default:
 		/* anything else is not-found */
 		return ROA_NOTFOUND;
 	}
+
+	if (validity != ROA_NOTFOUND)
+		th->hit_cnt++;
+	else
+		th->miss_cnt++;
+	return validity;
 }
 
 static int
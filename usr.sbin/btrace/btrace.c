@@ -97,8 +97,8 @@ struct bt_arg		*ba_read(struct bt_arg *);
 struct bt_arg		*baeval(struct bt_arg *, struct dt_evt *);
 const char		*ba2hash(struct bt_arg *, struct dt_evt *);
 long			 baexpr2long(struct bt_arg *, struct dt_evt *);
-const char		*ba2bucket(struct bt_arg *, struct bt_arg *,
-			     struct dt_evt *, long *);
+int			 ba2bucket(struct bt_arg *, struct bt_arg *,
+			     struct dt_evt *, long *, long *);
 int			 ba2dtflags(struct bt_arg *);
 
 /*
@@ -418,7 +418,12 @@ rules_do(int fd)
 	halt = rules_setup(fd);
 
 	while (!quit_pending && !halt && g_nprobes > 0) {
-		static struct dt_evt devtbuf[64];
+		/*
+		 * Pull events out of the kernel in large batches; with
+		 * high-frequency probes the read(2) rate, not the
+		 * per-event work, dominates btrace's own overhead.
+		 */
+		static struct dt_evt devtbuf[1024];
 		ssize_t rlen;
 		size_t i;
 
@@ -707,11 +712,13 @@ rule_printmaps(struct bt_rule *r)
 			if (map == NULL)
 				continue;
 
-			if (ba->ba_type == B_AT_MAP)
+			if (ba->ba_type == B_AT_MAP) {
 				map_print(map, SIZE_T_MAX, bv_name(bv));
-			else
+				map_clear(map);
+			} else {
 				hist_print((struct hist *)map, bv_name(bv));
-			map_clear(map);
+				hist_clear((struct hist *)map);
+			}
 			bv->bv_value = NULL;
 		}
 	}
@@ -884,20 +891,18 @@ stmt_bucketize(struct bt_stmt *bs, struct dt_evt *dtev)
 	struct bt_arg *bval = (struct bt_arg *)bs->bs_var;
 	struct bt_var *bv = bhist->ba_value;
 	struct hist *hist;
-	const char *bucket;
-	long step = 0;
+	long bucket, step = 0;
 
 	assert(bhist->ba_type == B_AT_HIST);
 	assert(SLIST_NEXT(bval, ba_next) == NULL);
 
 	brange = bhist->ba_key;
-	bucket = ba2bucket(bval, brange, dtev, &step);
-	if (bucket == NULL) {
+	if (ba2bucket(bval, brange, dtev, &bucket, &step) == -1) {
 		debug("hist=%p '%s' value=%lu out of range\n", bv->bv_value,
 		    bv_name(bv), ba2long(bval, dtev));
 		return;
 	}
-	debug("hist=%p '%s' increment bucket '%s'\n", bv->bv_value,
+	debug("hist=%p '%s' increment bucket '%ld'\n", bv->bv_value,
 	    bv_name(bv), bucket);
 
 	/* hist is NULL before first insert or after clear() */
@@ -907,8 +912,8 @@ stmt_bucketize(struct bt_stmt *bs, struct dt_evt *dtev)
 
 	hist_increment(hist, bucket);
 
-	debug("hist=%p '%s' increment bucket=%p '%s' bval=%p\n", hist,
-	    bv_name(bv), brange, bucket, bval);
+	debug("hist=%p '%s' increment bucket=%ld bval=%p\n", hist,
+	    bv_name(bv), bucket, bval);
 
 	bv->bv_value = (struct bt_arg *)hist;
 	bv->bv_type = B_VT_HIST;
@@ -932,10 +937,12 @@ stmt_clear(struct bt_stmt *bs)
 	if (map == NULL)
 		return;
 
-	if (bv->bv_type != B_VT_MAP && bv->bv_type != B_VT_HIST)
+	if (bv->bv_type == B_VT_MAP)
+		map_clear(map);
+	else if (bv->bv_type == B_VT_HIST)
+		hist_clear((struct hist *)map);
+	else
 		errx(1, "invalid variable type for clear(%s)", ba_name(ba));
-
-	map_clear(map);
 	bv->bv_value = NULL;
 
 	debug("map=%p '%s' clear\n", map, bv_name(bv));
@@ -1233,11 +1240,13 @@ stmt_zero(struct bt_stmt *bs)
 	if (map == NULL)
 		return;
 
-	if (bv->bv_type != B_VT_MAP && bv->bv_type != B_VT_HIST)
+	if (bv->bv_type == B_VT_MAP)
+		map_zero(map);
+	else if (bv->bv_type == B_VT_HIST)
+		hist_zero((struct hist *)map);
+	else
 		errx(1, "invalid variable type for zero(%s)", ba_name(ba));
 
-	map_zero(map);
-
 	debug("map=%p '%s' zero\n", map, bv_name(bv));
 }
 
@@ -1349,20 +1358,18 @@ next_pow2(unsigned long x)
 }
 
 /*
- * Return the ceiling value the interval holding `ba' or NULL if it is
- * out of the (min, max) values.
+ * Store the ceiling value of the interval holding `ba' in `pbucket'.
+ * Return -1 if it is out of the (min, max) values.
  */
-const char *
+int
 ba2bucket(struct bt_arg *ba, struct bt_arg *brange, struct dt_evt *dtev,
-    long *pstep)
+    long *pbucket, long *pstep)
 {
-	static char buf[KLEN];
-	long val, bucket;
-	int l;
+	long val;
 
 	val = ba2long(ba, dtev);
 	if (brange == NULL)
-		bucket = next_pow2(val);
+		*pbucket = next_pow2(val);
 	else {
 		long min, max, step;
 
@@ -1374,24 +1381,17 @@ ba2bucket(struct bt_arg *ba, struct bt_arg *brange, struct dt_evt *dtev,
 		max = ba2long(brange, NULL);
 
 		if ((val < min) || (val > max))
-			return NULL;
+			return -1;
 
 		brange = SLIST_NEXT(brange, ba_next);
 		assert(brange->ba_type == B_AT_LONG);
 		step = ba2long(brange, NULL);
 
-		bucket = ((val / step) + 1) * step;
+		*pbucket = ((val / step) + 1) * step;
 		*pstep = step;
 	}
 
-	buf[0] = '\0';
-	l = snprintf(buf, sizeof(buf), "%lu", bucket);
-	if (l < 0 || (size_t)l > sizeof(buf)) {
-		warn("string too long %d > %lu", l, sizeof(buf));
-		return buf;
-	}
-
-	return buf;
+	return 0;
 }
 
 /*
@@ -54,8 +54,10 @@ void			 map_insert(struct map *, const char *, void *);
 void			 map_print(struct map *, size_t, const char *);
 void			 map_zero(struct map *);
 struct hist		*hist_new(long);
-void			 hist_increment(struct hist *, const char *);
+void			 hist_clear(struct hist *);
+void			 hist_increment(struct hist *, long);
 void			 hist_print(struct hist *, const char *);
+void			 hist_zero(struct hist *);
 
 #define KLEN	1024	/* # of characters in map key, contain a stack trace */
 #define STRLEN	128	/* maximum # of bytes to output via str() function */
@@ -189,10 +189,19 @@ map_zero(struct map *map)
 }
 
 /*
- * Histogram implemented with map.
+ * Histogram implemented as an array of bins sorted by ascending
+ * bucket, so that incrementing a bin is a binary search and a
+ * counter bump.  The number of bins stays small: one per power of
+ * two for hist() and one per step for lhist().
  */
+struct hist_bin {
+	long		hb_bucket;	/* upper bound of the interval */
+	long		hb_count;
+};
+
 struct hist {
-	struct map	hmap;
+	struct hist_bin	*hbins;		/* sorted by ascending bucket */
+	int		hnbins;
 	int		hstep;
 };
 
@@ -210,17 +219,51 @@ hist_new(long step)
 }
 
 void
-hist_increment(struct hist *hist, const char *bucket)
+hist_increment(struct hist *hist, long bucket)
 {
-	struct bt_arg *ba;
-	long val;
+	struct hist_bin *bin;
+	int min, max, mid;
+
+	min = 0;
+	max = hist->hnbins;
+	while (min < max) {
+		mid = (min + max) / 2;
+		if (hist->hbins[mid].hb_bucket == bucket) {
+			hist->hbins[mid].hb_count++;
+			return;
+		}
+		if (hist->hbins[mid].hb_bucket < bucket)
+			min = mid + 1;
+		else
+			max = mid;
+	}
+
+	bin = reallocarray(hist->hbins, hist->hnbins + 1, sizeof(*bin));
+	if (bin == NULL)
+		err(1, "hist: reallocarray");
+	hist->hbins = bin;
 
-	ba = map_get(&hist->hmap, bucket);
+	bin += min;
+	memmove(bin + 1, bin, (hist->hnbins - min) * sizeof(*bin));
+	bin->hb_bucket = bucket;
+	bin->hb_count = 1;
+	hist->hnbins++;
+}
 
-	assert(ba->ba_type == B_AT_LONG);
-	val = (long)ba->ba_value;
-	val++;
-	ba->ba_value = (void *)val;
+void
+hist_zero(struct hist *hist)
+{
+	int i;
+
+	for (i = 0; i < hist->hnbins; i++)
+		hist->hbins[i].hb_count = 0;
+}
+
+void
+hist_clear(struct hist *hist)
+{
+	free(hist->hbins);
+	free(hist);
 }
 
 long
@@ -300,51 +343,29 @@ hist_print_bucket(char *buf, size_t buflen, long upb, long hstep)
 void
 hist_print(struct hist *hist, const char *name)
 {
-	struct map *map = &hist->hmap;
 	static char buf[80];
-	struct mentry *mep, *mcur;
-	long bmin, bprev, bin, val, max = 0;
-	int i, l, length = 52;
+	long val, max = 0;
+	int b, i, l, length = 52;
 
-	if (map == NULL)
+	if (hist == NULL)
 		return;
 
-	bprev = 0;
-	RB_FOREACH(mep, map, map) {
-		val = ba2long(mep->mval, NULL);
+	for (b = 0; b < hist->hnbins; b++) {
+		val = hist->hbins[b].hb_count;
 		if (val > max)
 			max = val;
 	}
 	printf("@%s:\n", name);
 
-	/*
-	 * Sort by ascending key.
-	 */
-	bprev = -1;
-	for (;;) {
-		mcur = NULL;
-		bmin = LONG_MAX;
-
-		RB_FOREACH(mep, map, map) {
-			bin = atol(mep->mkey);
-			if ((bin <= bmin) && (bin > bprev)) {
-				mcur = mep;
-				bmin = bin;
-			}
-		}
-		if (mcur == NULL)
-			break;
-
-		bin = atol(mcur->mkey);
-		val = ba2long(mcur->mval, NULL);
+	for (b = 0; b < hist->hnbins; b++) {
+		val = hist->hbins[b].hb_count;
 		i = (length * val) / max;
-		l = hist_print_bucket(buf, sizeof(buf), bin, hist->hstep);
+		l = hist_print_bucket(buf, sizeof(buf),
+		    hist->hbins[b].hb_bucket, hist->hstep);
 		snprintf(buf + l, sizeof(buf) - l, "%*ld |%.*s%*s|",
 		    20 - l, val,
 		    i, "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@",
 		    length - i, "");
 		printf("%s\n", buf);
-
-		bprev = bin;
 	}
 }
@@ -43,6 +43,17 @@
 
 static	void		process_crontab(int, const char *, const char *,
 					struct stat *, cron_db *, cron_db *);
+static	int		user_cmp(user *, user *);
+
+RB_PROTOTYPE_STATIC(user_tree, _user, node, user_cmp);
+
+static int
+user_cmp(user *a, user *b)
+{
+	return (strcmp(a->name, b->name));
+}
+
+RB_GENERATE_STATIC(user_tree, _user, node, user_cmp);
 
 void
 load_database(cron_db **db)
@@ -90,6 +101,7 @@ load_database(cron_db **db)
 		return;
 	new_db->mtime = mtime;
 	TAILQ_INIT(&new_db->users);
+	RB_INIT(&new_db->tree);
 
 	if (timespecisset(&syscron_stat.st_mtim)) {
 		process_crontab(AT_FDCWD, "*system*", _PATH_SYS_CRONTAB,
@@ -107,9 +119,12 @@ load_database(cron_db **db)
 		    (u = TAILQ_FIRST(&old_db->users))) {
 			if (strcmp(u->name, "*system*") == 0) {
 				TAILQ_REMOVE(&old_db->users, u, entries);
+				RB_REMOVE(user_tree, &old_db->tree, u);
 				free_user(u);
 				TAILQ_INSERT_HEAD(&old_db->users,
 				    TAILQ_FIRST(&new_db->users), entries);
+				RB_INSERT(user_tree, &old_db->tree,
+				    TAILQ_FIRST(&old_db->users));
 			}
 		}
 		free(new_db);
@@ -141,6 +156,7 @@ load_database(cron_db **db)
 	if (old_db != NULL) {
 		while ((u = TAILQ_FIRST(&old_db->users))) {
 			TAILQ_REMOVE(&old_db->users, u, entries);
+			RB_REMOVE(user_tree, &old_db->tree, u);
 			free_user(u);
 		}
 		free(old_db);
@@ -154,15 +170,12 @@ load_database(cron_db **db)
 user *
 find_user(cron_db *db, const char *name)
 {
-	user *u = NULL;
+	user key;
 
-	if (db != NULL) {
-		TAILQ_FOREACH(u, &db->users, entries) {
-			if (strcmp(u->name, name) == 0)
-				break;
-		}
-	}
-	return (u);
+	if (db == NULL)
+		return (NULL);
+	key.name = (char *)name;
+	return (RB_FIND(user_tree, &db->tree, &key));
 }
 
 static void
@@ -232,7 +245,9 @@ process_crontab(int dfd, const char *uname, const char *fname,
 		 */
 		if (timespeccmp(&u->mtime, &statbuf->st_mtim, ==)) {
 			TAILQ_REMOVE(&old_db->users, u, entries);
+			RB_REMOVE(user_tree, &old_db->tree, u);
 			TAILQ_INSERT_TAIL(&new_db->users, u, entries);
+			RB_INSERT(user_tree, &new_db->tree, u);
 			goto next_crontab;
 		}
 		syslog(LOG_INFO, "(%s) RELOAD (%s)", uname, fname);
@@ -243,14 +258,18 @@ process_crontab(int dfd, const char *uname, const char *fname,
 		/* Insert user into the new database and remove from old. */
 		new_u->mtime = statbuf->st_mtim;
 		TAILQ_INSERT_TAIL(&new_db->users, new_u, entries);
+		RB_INSERT(user_tree, &new_db->tree, new_u);
 		if (u != NULL) {
 			TAILQ_REMOVE(&old_db->users, u, entries);
+			RB_REMOVE(user_tree, &old_db->tree, u);
 			free_user(u);
 		}
 	} else if (u != NULL) {
 		/* New user crontab failed to load, preserve the old one. */
 		TAILQ_REMOVE(&old_db->users, u, entries);
+		RB_REMOVE(user_tree, &old_db->tree, u);
 		TAILQ_INSERT_TAIL(&new_db->users, u, entries);
+		RB_INSERT(user_tree, &new_db->tree, u);
 	}
 
  next_crontab:
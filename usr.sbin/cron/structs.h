@@ -18,6 +18,7 @@
  */
 
 #include <sys/queue.h>
+#include <sys/tree.h>
 
 struct passwd;
 
@@ -51,6 +52,7 @@ typedef	struct _entry {
 
 typedef	struct _user {
 	TAILQ_ENTRY(_user) entries;	/* links */
+	RB_ENTRY(_user)	node;		/* lookup by name */
 	char		*name;
 	struct timespec	mtime;		/* last modtime of crontab */
 	SLIST_HEAD(crontab_list, _entry) crontab;	/* this person's crontab */
@@ -58,6 +60,7 @@ typedef	struct _user {
 
 typedef	struct _cron_db {
 	TAILQ_HEAD(user_list, _user) users;
+	RB_HEAD(user_tree, _user) tree;	/* users keyed by name */
 	struct timespec	mtime;		/* last modtime on spooldir */
 } cron_db;
 
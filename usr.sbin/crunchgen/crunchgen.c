@@ -954,7 +954,8 @@ top_makefile_rules(FILE * outmk)
 	fprintf(outmk, "\t    < %s.map | tr '\\012' ' ' >$@\n", execfname);
 	fprintf(outmk, ".endif\n\n");
 
-	fprintf(outmk, "all: objs exe\nobjs: $(SUBMAKE_TARGETS)\n");
+	/* the .WAIT keeps the two phases apart under make -j */
+	fprintf(outmk, "all: objs .WAIT exe\nobjs: $(SUBMAKE_TARGETS)\n");
 	fprintf(outmk, "exe: %s\n", execfname);
 	fprintf(outmk, "clean:\n\trm -f %s *.lo *.o *_stub.c\n",
 	    execfname);
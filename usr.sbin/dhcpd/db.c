@@ -63,6 +63,7 @@ FILE *db_file;
 
 static int counting = 0;
 static int count = 0;
+static int nleases = 0;		/* leases in the database at last rewrite */
 time_t write_time;
 
 /*
@@ -78,6 +79,8 @@ write_lease(struct lease *lease)
 
 	if (counting)
 		++count;
+	else
+		++nleases;
 	if (fprintf(db_file, "lease %s {\n", piaddr(lease->ip_addr)) == -1)
 		++errors;
 
@@ -178,10 +181,14 @@ commit_leases(void)
 	}
 
 	/*
-	 * If we've written more than a thousand leases or if we haven't
-	 * rewritten the lease database in over an hour, rewrite it now.
+	 * Rewrite the lease database once the appended records outnumber
+	 * the leases it held at the last rewrite, so the cost of the
+	 * rewrite amortizes to a constant per commit no matter how large
+	 * the database grows, or if we haven't rewritten it in over an
+	 * hour.
 	 */
-	if (count > 1000 || (count && cur_time - write_time > 3600)) {
+	if (count > 1000 + nleases ||
+	    (count && cur_time - write_time > 3600)) {
 		count = 0;
 		write_time = cur_time;
 		new_lease_file();
@@ -217,6 +224,7 @@ new_lease_file(void)
 
 	/* Write out all the leases that we know of... */
 	counting = 0;
+	nleases = 0;
 	write_leases();
 
 	fflush(db_file);
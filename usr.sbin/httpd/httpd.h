@@ -439,6 +439,7 @@ struct log_file {
 	char			log_name[PATH_MAX];
 	int			log_fd;
 	uint32_t		log_id;
+	struct evbuffer		*log_buf;
 	TAILQ_ENTRY(log_file)	log_entry;
 };
 extern TAILQ_HEAD(log_files, log_file) log_files;
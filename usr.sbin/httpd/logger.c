@@ -42,8 +42,15 @@ int		 logger_open(struct server *, struct server_config *, void *);
 void		 logger_init(struct privsep *, struct privsep_proc *p, void *);
 int		 logger_start(void);
 int		 logger_log(struct imsg *);
+int		 logger_flush_file(struct log_file *);
+void		 logger_flush(int, short, void *);
+
+/* flush a log file as soon as this much output is pending */
+#define LOGGER_BUF_MAX		65536
 
 static uint32_t		 last_log_id = 0;
+static struct event	 logger_flush_ev;
+static struct timeval	 logger_flush_tv = { 1, 0 };
 
 struct log_files log_files;
 
@@ -77,6 +84,8 @@ logger_init(struct privsep *ps, struct privsep_proc *p, void *arg)
 	/* We use a custom shutdown callback */
 	p->p_shutdown = logger_shutdown;
 
+	evtimer_set(&logger_flush_ev, logger_flush, NULL);
+
 	TAILQ_INIT(&log_files);
 }
 
@@ -85,11 +94,16 @@ logger_close(void)
 {
 	struct log_file	*log, *next;
 
+	if (evtimer_pending(&logger_flush_ev, NULL))
+		evtimer_del(&logger_flush_ev);
+
 	TAILQ_FOREACH_SAFE(log, &log_files, log_entry, next) {
 		if (log->log_fd != -1) {
+			(void)logger_flush_file(log);
 			close(log->log_fd);
 			log->log_fd = -1;
 		}
+		evbuffer_free(log->log_buf);
 		TAILQ_REMOVE(&log_files, log, log_entry);
 		free(log);
 	}
@@ -106,6 +120,12 @@ logger_open_file(const char *name)
 		return (NULL);
 	}
 
+	if ((log->log_buf = evbuffer_new()) == NULL) {
+		log_warn("failed to allocate log buffer for %s", name);
+		free(log);
+		return (NULL);
+	}
+
 	log->log_id = ++last_log_id;
 	(void)strlcpy(log->log_name, name, sizeof(log->log_name));
 
@@ -128,6 +148,7 @@ logger_open_file(const char *name)
 	return (log);
 
 err:
+	evbuffer_free(log->log_buf);
 	free(log);
 
 	return (NULL);
@@ -239,6 +260,39 @@ logger_start(void)
 	return (0);
 }
 
+int
+logger_flush_file(struct log_file *log)
+{
+	ssize_t	 n;
+
+	while (EVBUFFER_LENGTH(log->log_buf) > 0) {
+		if ((n = write(log->log_fd, EVBUFFER_DATA(log->log_buf),
+		    EVBUFFER_LENGTH(log->log_buf))) == -1) {
+			log_warn("failed to write log %s", log->log_name);
+			return (-1);
+		}
+		evbuffer_drain(log->log_buf, n);
+	}
+
+	return (0);
+}
+
+void
+logger_flush(int fd, short ev, void *arg)
+{
+	struct log_file	*log;
+
+	TAILQ_FOREACH(log, &log_files, log_entry) {
+		if (log->log_fd == -1)
+			continue;
+		if (logger_flush_file(log) == -1) {
+			/* reopens all log files and drops their buffers */
+			(void)logger_start();
+			return;
+		}
+	}
+}
+
 int
 logger_log(struct imsg *imsg)
 {
@@ -269,11 +323,25 @@ logger_log(struct imsg *imsg)
 	/* For debug output */
 	log_debug("%s", logline);
 
-	if (dprintf(log->log_fd, "%s\n", logline) == -1) {
-		if (logger_start() == -1)
-			return (-1);
+	/*
+	 * Collect lines in the per-file buffer so that busy logs are
+	 * written with one write() per event loop pass instead of one
+	 * per request; the timer bounds the delay for quiet logs.
+	 */
+	if (evbuffer_add_printf(log->log_buf, "%s\n", logline) == -1)
+		fatal("failed to buffer log line");
+
+	if (EVBUFFER_LENGTH(log->log_buf) >= LOGGER_BUF_MAX) {
+		if (logger_flush_file(log) == -1) {
+			if (logger_start() == -1)
+				return (-1);
+			return (0);
+		}
 	}
 
+	if (!evtimer_pending(&logger_flush_ev, NULL))
+		evtimer_add(&logger_flush_ev, &logger_flush_tv);
+
 	return (0);
 }
 
@@ -43,9 +43,9 @@
 int		 server_file_access(struct httpd *, struct client *,
 		    char *, size_t);
 int		 server_file_request(struct httpd *, struct client *,
-		    char *, struct timespec *);
+		    char *, struct stat *);
 int		 server_partial_file_request(struct httpd *, struct client *,
-		    char *, struct timespec *, char *);
+		    char *, struct stat *, char *);
 int		 server_file_index(struct httpd *, struct client *);
 int		 server_file_modified_since(struct http_descriptor *,
 		    struct timespec *);
@@ -141,9 +141,9 @@ server_file_access(struct httpd *env, struct client *clt,
 	r = kv_find(&desc->http_headers, &key);
 	if (r != NULL)
 		return (server_partial_file_request(env, clt, path,
-		    &st.st_mtim, r->kv_value));
+		    &st, r->kv_value));
 	else
-		return (server_file_request(env, clt, path, &st.st_mtim));
+		return (server_file_request(env, clt, path, &st));
 
  fail:
 	switch (errno) {
@@ -217,13 +217,13 @@ server_file_method(struct client *clt)
 
 int
 server_file_request(struct httpd *env, struct client *clt, char *path,
-    struct timespec *mtim)
+    struct stat *st)
 {
 	struct server_config	*srv_conf = clt->clt_srv_conf;
 	struct media_type	*media;
 	const char		*errstr = NULL;
 	int			 fd = -1, ret, code = 500;
-	struct stat		 st;
+	struct stat		 gzst;
 	size_t			 bufsiz;
 	char			 gzpath[PATH_MAX];
 
@@ -233,10 +233,11 @@ server_file_request(struct httpd *env, struct client *clt, char *path,
 	}
 
 	media = media_find_config(env, srv_conf, path);
-	if ((ret = server_file_modified_since(clt->clt_descreq, mtim)) != -1) {
+	if ((ret = server_file_modified_since(clt->clt_descreq,
+	    &st->st_mtim)) != -1) {
 		/* send the header without a body */
 		if ((ret = server_response_http(clt, ret, media, -1,
-		    MINIMUM(time(NULL), mtim->tv_sec))) == -1)
+		    MINIMUM(time(NULL), st->st_mtim.tv_sec))) == -1)
 			goto fail;
 		goto done;
 	}
@@ -258,13 +259,15 @@ server_file_request(struct httpd *env, struct client *clt, char *path,
 				goto abort;
 			if ((fd = open(gzpath, O_RDONLY)) != -1) {
 				/* .gz must be a file, and not older */
-				if (fstat(fd, &st) != -1 &&
-				    S_ISREG(st.st_mode) &&
-				    timespeccmp(&st.st_mtim, mtim, >=)) {
+				if (fstat(fd, &gzst) != -1 &&
+				    S_ISREG(gzst.st_mode) &&
+				    timespeccmp(&gzst.st_mtim,
+				    &st->st_mtim, >=)) {
 					kv_add(&resp->http_headers,
 					    "Content-Encoding", "gzip");
 					/* Use original file timestamp */
-					st.st_mtim = *mtim;
+					gzst.st_mtim = st->st_mtim;
+					st = &gzst;
 				} else {
 					close(fd);
 					fd = -1;
@@ -274,15 +277,11 @@ server_file_request(struct httpd *env, struct client *clt, char *path,
 	}
 
 	/* Now open the file, should be readable or we have another problem */
-	if (fd == -1) {
-		if ((fd = open(path, O_RDONLY)) == -1)
-			goto abort;
-		if (fstat(fd, &st) == -1)
-			goto abort;
-	}
+	if (fd == -1 && (fd = open(path, O_RDONLY)) == -1)
+		goto abort;
 
-	ret = server_response_http(clt, 200, media, st.st_size,
-	    MINIMUM(time(NULL), st.st_mtim.tv_sec));
+	ret = server_response_http(clt, 200, media, st->st_size,
+	    MINIMUM(time(NULL), st->st_mtim.tv_sec));
 	switch (ret) {
 	case -1:
 		goto fail;
@@ -307,7 +306,7 @@ server_file_request(struct httpd *env, struct client *clt, char *path,
 	}
 
 	/* Adjust read watermark to the optimal file io size */
-	bufsiz = MAXIMUM(st.st_blksize, 64 * 1024);
+	bufsiz = MAXIMUM(st->st_blksize, 64 * 1024);
 	bufferevent_setwatermark(clt->clt_srvbev, EV_READ, 0,
 	    bufsiz);
 
@@ -334,7 +333,7 @@ server_file_request(struct httpd *env, struct client *clt, char *path,
 
 int
 server_partial_file_request(struct httpd *env, struct client *clt, char *path,
-    struct timespec *mtim, char *range_str)
+    struct stat *st, char *range_str)
 {
 	struct server_config	*srv_conf = clt->clt_srv_conf;
 	struct http_descriptor	*resp = clt->clt_descresp;
@@ -343,25 +342,22 @@ server_partial_file_request(struct httpd *env, struct client *clt, char *path,
 	struct range_data	*r = &clt->clt_ranges;
 	struct range		*range;
 	size_t			 content_length = 0, bufsiz;
-	struct stat		 st;
 	int			 code = 500, fd = -1, i, nranges, ret;
 	char			 content_range[64];
 	const char		*errstr = NULL;
 
 	/* Ignore range request for methods other than GET */
 	if (desc->http_method != HTTP_METHOD_GET)
-		return server_file_request(env, clt, path, mtim);
+		return server_file_request(env, clt, path, st);
 
 	/* Now open the file, should be readable or we have another problem */
 	if ((fd = open(path, O_RDONLY)) == -1)
 		goto abort;
-	if (fstat(fd, &st) == -1)
-		goto abort;
 
-	if ((nranges = parse_ranges(clt, range_str, st.st_size)) < 1) {
+	if ((nranges = parse_ranges(clt, range_str, st->st_size)) < 1) {
 		code = 416;
 		(void)snprintf(content_range, sizeof(content_range),
-		    "bytes */%lld", st.st_size);
+		    "bytes */%lld", st->st_size);
 		errstr = content_range;
 		goto abort;
 	}
@@ -373,7 +369,7 @@ server_partial_file_request(struct httpd *env, struct client *clt, char *path,
 		range = &r->range[0];
 		(void)snprintf(content_range, sizeof(content_range),
 		    "bytes %lld-%lld/%lld", range->start, range->end,
-		    st.st_size);
+		    st->st_size);
 		if (kv_add(&resp->http_headers, "Content-Range",
 		    content_range) == NULL)
 			goto abort;
@@ -395,7 +391,7 @@ server_partial_file_request(struct httpd *env, struct client *clt, char *path,
 			    "Content-Range: bytes %lld-%lld/%lld\r\n\r\n",
 			    clt->clt_boundary,
 			    media->media_type, media->media_subtype,
-			    range->start, range->end, st.st_size)) < 0)
+			    range->start, range->end, st->st_size)) < 0)
 				goto abort;
 
 			/* Add data length */
@@ -420,7 +416,7 @@ server_partial_file_request(struct httpd *env, struct client *clt, char *path,
 	r->range_toread = TOREAD_HTTP_RANGE;
 
 	ret = server_response_http(clt, 206, media, content_length,
-	    MINIMUM(time(NULL), st.st_mtim.tv_sec));
+	    MINIMUM(time(NULL), st->st_mtim.tv_sec));
 	switch (ret) {
 	case -1:
 		goto fail;
@@ -445,7 +441,7 @@ server_partial_file_request(struct httpd *env, struct client *clt, char *path,
 	}
 
 	/* Adjust read watermark to the optimal file io size */
-	bufsiz = MAXIMUM(st.st_blksize, 64 * 1024);
+	bufsiz = MAXIMUM(st->st_blksize, 64 * 1024);
 	bufferevent_setwatermark(clt->clt_srvbev, EV_READ, 0,
 	    bufsiz);
 
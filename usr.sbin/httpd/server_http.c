@@ -226,7 +226,7 @@ server_read_http(struct bufferevent *bev, void *arg)
 	struct client		*clt = arg;
 	struct http_descriptor	*desc = clt->clt_descreq;
 	struct evbuffer		*src = EVBUFFER_INPUT(bev);
-	char			*line = NULL, *key, *value;
+	char			*line, *key, *value;
 	const char		*errstr;
 	char			*http_version, *query;
 	size_t			 size, linelen;
@@ -254,8 +254,18 @@ server_read_http(struct bufferevent *bev, void *arg)
 			}
 		}
 
-		if ((line = evbuffer_readln(src,
-		    &linelen, EVBUFFER_EOL_CRLF_STRICT)) == NULL) {
+		/*
+		 * Scan for the end of line in place instead of copying
+		 * the line out of the buffer; the buffer is contiguous
+		 * and the line is consumed before more data arrives.
+		 */
+		line = EVBUFFER_DATA(src);
+		size = EVBUFFER_LENGTH(src);
+		for (linelen = 0; linelen + 1 < size; linelen++)
+			if (line[linelen] == '\r' &&
+			    line[linelen + 1] == '\n')
+				break;
+		if (linelen + 1 >= size) {
 			/* No newline found after too many bytes */
 			if (size > SERVER_MAXHEADERLENGTH) {
 				server_abort_http(clt, 413,
@@ -265,13 +275,13 @@ server_read_http(struct bufferevent *bev, void *arg)
 			break;
 		}
 
-		/*
-		 * An empty line indicates the end of the request.
-		 * libevent already stripped the \r\n for us.
-		 */
+		/* Terminate the line, overwriting the \r */
+		line[linelen] = '\0';
+
+		/* An empty line indicates the end of the request */
 		if (!linelen) {
 			clt->clt_headersdone = 1;
-			free(line);
+			evbuffer_drain(src, 2);
 			break;
 		}
 		key = line;
@@ -311,7 +321,7 @@ server_read_http(struct bufferevent *bev, void *arg)
 			    desc->http_lastheader, line) == NULL)
 				goto fail;
 
-			free(line);
+			evbuffer_drain(src, linelen + 2);
 			continue;
 		}
 		if (*value == ':') {
@@ -422,7 +432,7 @@ server_read_http(struct bufferevent *bev, void *arg)
 			desc->http_lastheader = hdr;
 		}
 
-		free(line);
+		evbuffer_drain(src, linelen + 2);
 	}
 	if (clt->clt_headersdone) {
 		if (desc->http_method == HTTP_METHOD_NONE) {
@@ -505,7 +515,7 @@ server_read_http(struct bufferevent *bev, void *arg)
  fail:
 	server_abort_http(clt, 500, strerror(errno));
  abort:
-	free(line);
+	return;
 }
 
 void
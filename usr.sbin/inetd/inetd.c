@@ -135,6 +135,7 @@
 #include <err.h>
 #include <errno.h>
 #include <ctype.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <netdb.h>
 #include <syslog.h>
@@ -158,6 +159,7 @@
 #define	TOOMANY		256		/* don't start more than TOOMANY */
 #define	CNT_INTVL	60		/* servers in CNT_INTVL sec. */
 #define	RETRYTIME	(60*10)		/* retry after bind or server fail */
+#define	MAXACCEPT	16		/* accepts per wakeup per service */
 
 int	 debug = 0;
 int	 maxsock;
@@ -390,44 +392,58 @@ void
 gettcp(int fd, short events, void *xsep)
 {
 	struct servtab *sep = xsep;
-	int ctrl;
+	int ctrl, n;
 
 	if (debug)
 		fprintf(stderr, "someone wants %s\n", sep->se_service);
 
-	ctrl = accept(sep->se_fd, NULL, NULL);
-	if (debug)
-		fprintf(stderr, "accept, ctrl %d\n", ctrl);
-	if (ctrl == -1) {
-		if (errno != EWOULDBLOCK && errno != EINTR &&
-		    errno != ECONNABORTED)
-			syslog(LOG_WARNING, "accept (for %s): %m",
-			    sep->se_service);
-		return;
-	}
-	if ((sep->se_family == AF_INET || sep->se_family == AF_INET6) &&
-	    sep->se_socktype == SOCK_STREAM) {
-		struct sockaddr_storage peer;
-		socklen_t plen = sizeof(peer);
-		char sbuf[NI_MAXSERV];
-
-		if (getpeername(ctrl, (struct sockaddr *)&peer, &plen) == -1) {
-			syslog(LOG_WARNING, "could not getpeername");
-			close(ctrl);
+	/*
+	 * Under a connection burst each accept used to cost a full pass
+	 * through the event loop.  Drain the listen queue while we are
+	 * here, but only so far that a busy service cannot starve the
+	 * others; anything left re-triggers the event immediately.
+	 */
+	for (n = 0; n < MAXACCEPT && sep->se_fd != -1; n++) {
+		ctrl = accept(sep->se_fd, NULL, NULL);
+		if (debug)
+			fprintf(stderr, "accept, ctrl %d\n", ctrl);
+		if (ctrl == -1) {
+			if (errno != EWOULDBLOCK && errno != EINTR &&
+			    errno != ECONNABORTED)
+				syslog(LOG_WARNING, "accept (for %s): %m",
+				    sep->se_service);
 			return;
 		}
-		if (getnameinfo((struct sockaddr *)&peer, plen, NULL, 0,
-		    sbuf, sizeof(sbuf), NI_NUMERICSERV) == 0 &&
-		    strtonum(sbuf, 1, USHRT_MAX, NULL) == 20) {
-			/*
-			 * ignore things that look like ftp bounce
-			 */
-			close(ctrl);
-			return;
+		/* the socket inherited non-blocking from the listener */
+		if (fcntl(ctrl, F_SETFL, 0) == -1)
+			syslog(LOG_WARNING, "fcntl (for %s): %m",
+			    sep->se_service);
+		if ((sep->se_family == AF_INET ||
+		    sep->se_family == AF_INET6) &&
+		    sep->se_socktype == SOCK_STREAM) {
+			struct sockaddr_storage peer;
+			socklen_t plen = sizeof(peer);
+			char sbuf[NI_MAXSERV];
+
+			if (getpeername(ctrl, (struct sockaddr *)&peer,
+			    &plen) == -1) {
+				syslog(LOG_WARNING, "could not getpeername");
+				close(ctrl);
+				continue;
+			}
+			if (getnameinfo((struct sockaddr *)&peer, plen, NULL,
+			    0, sbuf, sizeof(sbuf), NI_NUMERICSERV) == 0 &&
+			    strtonum(sbuf, 1, USHRT_MAX, NULL) == 20) {
+				/*
+				 * ignore things that look like ftp bounce
+				 */
+				close(ctrl);
+				continue;
+			}
 		}
-	}
 
-	spawn(ctrl, 0, sep);
+		spawn(ctrl, 0, sep);
+	}
 }
 
 int
@@ -877,6 +893,13 @@ setsockopt(fd, SOL_SOCKET, opt, &on, sizeof (on))
 		listen(sep->se_fd, 10);
 
 	if (!sep->se_wait && sep->se_socktype == SOCK_STREAM) {
+		/*
+		 * gettcp() accepts in a loop and must not hang if a
+		 * queued connection is aborted before we get to it.
+		 */
+		if (fcntl(sep->se_fd, F_SETFL, O_NONBLOCK) == -1)
+			syslog(LOG_ERR, "%s/%s: fcntl (O_NONBLOCK): %m",
+			    sep->se_service, sep->se_proto);
 		event_set(&sep->se_event, sep->se_fd, EV_READ|EV_PERSIST,
 		    gettcp, sep);
 	} else {
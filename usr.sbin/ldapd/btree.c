@@ -18,6 +18,7 @@
 
 #include <sys/types.h>
 #include <sys/tree.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/queue.h>
 #include <sys/uio.h>
@@ -212,6 +213,8 @@ struct btree {
 	int			 ref;		/* increased by cursors & txn */
 	struct btree_stat	 stat;
 	off_t			 size;		/* current file size */
+	char			*map;		/* read-only file mapping */
+	off_t			 map_size;	/* size of the file mapping */
 };
 
 #define NODESIZE	 offsetof(struct node, data)
@@ -242,6 +245,7 @@ static int		 btree_search_page(struct btree *bt,
 
 static int		 btree_write_header(struct btree *bt, int fd);
 static int		 btree_read_header(struct btree *bt);
+static void		 btree_remap(struct btree *bt);
 static int		 btree_is_meta_page(struct page *p);
 static int		 btree_read_meta(struct btree *bt, pgno_t *p_next);
 static int		 btree_write_meta(struct btree *bt, pgno_t root,
@@ -601,13 +605,49 @@ mpage_touch(struct btree *bt, struct mpage *mp)
 	return mp;
 }
 
+/* Map the database file read-only up to its current size. Committed pages
+ * are then served from the mapping without any syscalls. The old mapping
+ * is safe to drop as cached pages hold private copies.
+ */
+static void
+btree_remap(struct btree *bt)
+{
+	char		*map;
+
+	if (bt->map != NULL) {
+		munmap(bt->map, bt->map_size);
+		bt->map = NULL;
+		bt->map_size = 0;
+	}
+
+	if (bt->size <= 0)
+		return;
+
+	map = mmap(NULL, bt->size, PROT_READ, MAP_SHARED, bt->fd, 0);
+	if (map == MAP_FAILED) {
+		DPRINTF("mmap: %s", strerror(errno));
+		return;		/* fall back to pread */
+	}
+	bt->map = map;
+	bt->map_size = bt->size;
+}
+
 static int
 btree_read_page(struct btree *bt, pgno_t pgno, struct page *page)
 {
 	ssize_t		 rc;
+	off_t		 off;
 
 	DPRINTF("reading page %u", pgno);
 	bt->stat.reads++;
+
+	/* Serve the page from the file mapping when it is covered. */
+	off = (off_t)pgno * bt->head.psize;
+	if (bt->map != NULL && off + bt->head.psize <= bt->map_size) {
+		bcopy(bt->map + off, page, bt->head.psize);
+		return BT_SUCCESS;
+	}
+
 	if ((rc = pread(bt->fd, page, bt->head.psize, (off_t)pgno*bt->head.psize)) == 0) {
 		DPRINTF("page %u doesn't exist", pgno);
 		errno = ENOENT;
@@ -962,6 +1002,7 @@ btree_write_meta(struct btree *bt, pgno_t root, unsigned int flags)
 		DPRINTF("failed to update file size: %s", strerror(errno));
 		bt->size = 0;
 	}
+	btree_remap(bt);
 
 	return BT_SUCCESS;
 }
@@ -1052,6 +1093,7 @@ btree_read_meta(struct btree *bt, pgno_t *p_next)
 			return BT_SUCCESS;
 	}
 	bt->size = size;
+	btree_remap(bt);
 
 	while (meta_pgno > 0) {
 		if ((mp = btree_get_mpage(bt, meta_pgno)) == NULL)
@@ -1131,6 +1173,8 @@ btree_open_fd(int fd, unsigned int flags)
 	return bt;
 
 fail:
+	if (bt->map != NULL)
+		munmap(bt->map, bt->map_size);
 	free(bt->lru_queue);
 	free(bt->page_cache);
 	free(bt);
@@ -1176,6 +1220,8 @@ btree_close(struct btree *bt)
 
 	if (--bt->ref == 0) {
 		DPRINTF("ref is zero, closing btree %p", bt);
+		if (bt->map != NULL)
+			munmap(bt->map, bt->map_size);
 		close(bt->fd);
 		mpage_flush(bt);
 		free(bt->lru_queue);
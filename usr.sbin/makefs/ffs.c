@@ -491,28 +491,36 @@ ffs_create_image(const char *image, fsinfo_t *fsopts)
 	}
 
 		/* zero image */
-	bufsize = 8192;
-	bufrem = fsopts->size;
-
-	if (fsopts->offset != 0)
+	if (fsopts->offset == 0) {
+		/*
+		 * The image was just truncated and extending it with
+		 * ftruncate() makes it read back as zeros, sparing one
+		 * full write of the image before the data even goes in.
+		 */
+		if (ftruncate(fsopts->fd, fsopts->size) == -1) {
+			warn("can't extend image");
+			return (-1);
+		}
+	} else {
 		if (lseek(fsopts->fd, fsopts->offset, SEEK_SET) == -1) {
 			warn("can't seek");
 			return -1;
 		}
-
-	if (bufrem > 0)
+		bufsize = MAXPHYS;
+		bufrem = fsopts->size;
 		buf = ecalloc(1, bufsize);
-	while (bufrem > 0) {
-		i = write(fsopts->fd, buf, MINIMUM(bufsize, bufrem));
-		if (i == -1) {
-			warn("zeroing image, %lld bytes to go",
-			    (long long)bufrem);
-			free(buf);
-			return (-1);
+		while (bufrem > 0) {
+			i = write(fsopts->fd, buf, MINIMUM(bufsize, bufrem));
+			if (i == -1) {
+				warn("zeroing image, %lld bytes to go",
+				    (long long)bufrem);
+				free(buf);
+				return (-1);
+			}
+			bufrem -= i;
 		}
-		bufrem -= i;
+		free(buf);
 	}
-	free(buf);
 
 		/* make the file system */
 	if (Tflag) {
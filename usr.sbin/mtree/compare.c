@@ -45,7 +45,7 @@
 #include "mtree.h"
 #include "extern.h"
 
-extern int lflag, tflag, uflag;
+extern int lflag, mflag, tflag, uflag;
 
 static char *ftype(u_int);
 
@@ -218,6 +218,19 @@ typeerr:		LABEL;
 			tab = "\t";
 		}
 	}
+	/*
+	 * With -m, a matching size and modification time vouch for the
+	 * contents and the checksum and digest recomputation is skipped.
+	 * A file modified through the file system cannot keep both
+	 * intact, so this catches accidental corruption, but not an
+	 * attacker who can also restore the timestamp.
+	 */
+	if (mflag && s->type == F_FILE &&
+	    s->flags & F_SIZE && s->flags & F_TIME &&
+	    s->st_size == p->fts_statp->st_size &&
+	    s->st_mtim.tv_sec == p->fts_statp->st_mtim.tv_sec &&
+	    s->st_mtim.tv_nsec == p->fts_statp->st_mtim.tv_nsec)
+		goto unchanged;
 	if (s->flags & F_CKSUM) {
 		if ((fd = open(p->fts_accpath, MTREE_O_FLAGS)) == -1) {
 			LABEL;
@@ -304,6 +317,7 @@ typeerr:		LABEL;
 			tab = "\t";
 		}
 	}
+unchanged:
 	if (s->flags & F_SLINK && strcmp(cp = rlink(name), s->slink)) {
 		LABEL;
 		(void)printf("%slink ref (%s, %s)\n", tab, cp, s->slink);
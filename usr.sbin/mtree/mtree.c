@@ -45,8 +45,8 @@
 extern u_int32_t crc_total;
 
 int ftsoptions = FTS_PHYSICAL;
-int cflag, dflag, eflag, iflag, lflag, nflag, qflag, rflag, sflag, tflag,
-    uflag, Uflag;
+int cflag, dflag, eflag, iflag, lflag, mflag, nflag, qflag, rflag, sflag,
+    tflag, uflag, Uflag;
 u_int keys;
 char fullpath[PATH_MAX];
 
@@ -61,7 +61,7 @@ main(int argc, char *argv[])
 
 	dir = NULL;
 	keys = KEYDEFAULT;
-	while ((ch = getopt(argc, argv, "cdef:iK:k:lnp:qrs:tUux")) != -1)
+	while ((ch = getopt(argc, argv, "cdef:iK:k:lmnp:qrs:tUux")) != -1)
 		switch(ch) {
 		case 'c':
 			cflag = 1;
@@ -93,6 +93,9 @@ main(int argc, char *argv[])
 		case 'l':
 			lflag = 1;
 			break;
+		case 'm':
+			mflag = 1;
+			break;
 		case 'n':
 			nflag = 1;
 			break;
@@ -167,6 +170,10 @@ main(int argc, char *argv[])
 	if (lflag == 1 && uflag == 1)
 		error("-l and -u flags are mutually exclusive");
 
+	/* The seed checksum must cover every file. */
+	if (mflag == 1 && sflag == 1)
+		error("-m and -s flags are mutually exclusive");
+
 	if (cflag) {
 		cwalk();
 		exit(0);
@@ -181,7 +188,7 @@ static void
 usage(void)
 {
 	(void)fprintf(stderr,
-	    "usage: mtree [-cdeilnqrtUux] [-f spec] [-K keywords] "
+	    "usage: mtree [-cdeilmnqrtUux] [-f spec] [-K keywords] "
 	    "[-k keywords] [-p path]\n"
 	    "             [-s seed]\n");
 	exit(1);
@@ -92,6 +92,8 @@ static int          npppd_rd_walktree_delete(struct radish_head *);
 static __dead void  usage (void);
 static void         npppd_stop_really (npppd *);
 static uint32_t     str_hash(const void *, int);
+static int          ppp_id_cmp(const void *, const void *);
+static uint32_t     ppp_id_hash(const void *, int);
 static void         npppd_on_sighup (int, short, void *);
 static void         npppd_on_sigterm (int, short, void *);
 static void         npppd_on_sigint (int, short, void *);
@@ -313,6 +315,13 @@ npppd_init(npppd *_this, const char *config_file)
 		return -1;
 	}
 
+	if ((_this->map_id_ppp = hash_create(ppp_id_cmp, ppp_id_hash,
+	    NPPPD_USER_HASH_SIZ)) == NULL) {
+		log_printf(LOG_ERR, "hash_create() failed in %s(): %m",
+		    __func__);
+		return -1;
+	}
+
 	if (npppd_ifaces_load_config(_this) != 0) {
 		return -1;
 	}
@@ -518,6 +527,8 @@ npppd_fini(npppd *_this)
 
 	if (_this->map_user_ppp != NULL)
 		hash_free(_this->map_user_ppp);
+	if (_this->map_id_ppp != NULL)
+		hash_free(_this->map_id_ppp);
 }
 
 /***********************************************************************
@@ -784,29 +795,15 @@ npppd_get_ppp_by_user(npppd *_this, const char *username)
 npppd_ppp *
 npppd_get_ppp_by_id(npppd *_this, u_int ppp_id)
 {
-	slist users;
-	npppd_ppp *ppp0, *ppp;
+	hash_link *hl;
 
 	NPPPD_ASSERT(_this != NULL);
 
-	ppp = NULL;
-	slist_init(&users);
-	if (npppd_get_all_users(_this, &users) != 0) {
-		log_printf(LOG_WARNING,
-		    "npppd_get_all_users() failed in %s()", __func__);
-	} else {
-		/* FIXME: This linear search eats CPU. */
-		for (slist_itr_first(&users); slist_itr_has_next(&users); ) {
-			ppp0 = slist_itr_next(&users);
-			if (ppp0->id == ppp_id) {
-				ppp = ppp0;
-				break;
-			}
-		}
-	}
-	slist_fini(&users);
+	if ((hl = hash_lookup(_this->map_id_ppp,
+	    (void *)(uintptr_t)ppp_id)) != NULL)
+		return hl->item;
 
-	return ppp;
+	return NULL;
 }
 
 static struct ipcpstat *
@@ -1993,6 +1990,19 @@ str_hash(const void *ptr, int sz)
 	return hash % sz;
 }
 
+/* the ppp id itself is used as the key, disguised as a pointer */
+static int
+ppp_id_cmp(const void *a, const void *b)
+{
+	return (a != b);
+}
+
+static uint32_t
+ppp_id_hash(const void *ptr, int sz)
+{
+	return (uintptr_t)ptr % sz;
+}
+
 /**
  * Select a authentication realm that is for given {@link ::npppd_ppp PPP}.
  * Return 0 on success.
@@ -2382,6 +2392,8 @@ npppd_on_ppp_start(npppd *_this, npppd_ppp *ppp)
 {
 	struct ctl_conn  *c;
 
+	hash_insert(_this->map_id_ppp, (void *)(uintptr_t)ppp->id, ppp);
+
 	TAILQ_FOREACH(c, &ctl_conns, entry) {
 		if (npppd_ctl_add_started_ppp_id(c->ctx, ppp->id) == 0) {
 			npppd_ctl_imsg_compose(c->ctx, &c->iev.ibuf);
@@ -2395,6 +2407,8 @@ npppd_on_ppp_stop(npppd *_this, npppd_ppp *ppp)
 {
 	struct ctl_conn  *c;
 
+	hash_delete(_this->map_id_ppp, (void *)(uintptr_t)ppp->id, 0);
+
 	TAILQ_FOREACH(c, &ctl_conns, entry) {
 		if (npppd_ctl_add_stopped_ppp(c->ctx, ppp) == 0) {
 			npppd_ctl_imsg_compose(c->ctx, &c->iev.ibuf);
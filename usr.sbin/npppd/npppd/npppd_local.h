@@ -122,6 +122,9 @@ struct _npppd {
 	/** map of username to slist of npppd_ppp */
 	hash_table *map_user_ppp;
 
+	/** map of ppp id to npppd_ppp */
+	hash_table *map_id_ppp;
+
 	/** authentication realms */
 	slist realms;
 
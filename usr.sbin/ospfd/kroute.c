@@ -253,10 +253,22 @@ kr_change_fib(struct kroute_node *kr, struct kroute *kroute, int krcount,
 			if (kn != NULL)
 				/* nexthop already present, skip it */
 				continue;
-		} else
+		} else {
 			/* modify first entry */
 			kn = kr;
 
+			/*
+			 * After every SPF run the RDE resends the whole
+			 * routing table.  If the installed route already
+			 * matches, don't bother the kernel with it.
+			 */
+			if (kn != NULL &&
+			    kn->r.nexthop.s_addr == kroute[i].nexthop.s_addr &&
+			    kn->r.rtlabel == kroute[i].rtlabel &&
+			    kn->r.ext_tag == kroute[i].ext_tag)
+				continue;
+		}
+
 		/* send update */
 		if (send_rtmsg(kr_state.fd, action, &kroute[i]) == -1)
 			return (-1);
@@ -42,6 +42,10 @@ int	 hce_dispatch_relay(int, struct privsep_proc *, struct imsg *);
 static struct relayd *env = NULL;
 int			 running = 0;
 
+/* number of launch ticks the check interval is divided into */
+#define HCE_SLOTS	 10
+static int		 hce_slot = 0;
+
 static struct privsep_proc procs[] = {
 	{ "parent",	PROC_PARENT,	hce_dispatch_parent },
 	{ "pfe",	PROC_PFE,	hce_dispatch_pfe },
@@ -132,6 +136,7 @@ hce_launch_checks(int fd, short event, void *arg)
 	struct host		*host;
 	struct table		*table;
 	struct timeval		 tv;
+	uint64_t		 usec;
 
 	/*
 	 * notify pfe checks are done and schedule next check
@@ -139,6 +144,8 @@ hce_launch_checks(int fd, short event, void *arg)
 	proc_compose(env->sc_ps, PROC_PFE, IMSG_SYNC, NULL, 0);
 	TAILQ_FOREACH(table, env->sc_tables, entry) {
 		TAILQ_FOREACH(host, &table->hosts, entry) {
+			if (host->conf.id % HCE_SLOTS != hce_slot)
+				continue;
 			if ((host->flags & F_CHECK_DONE) == 0)
 				host->he = HCE_INTERVAL_TIMEOUT;
 			if (event_initialized(&host->cte.ev)) {
@@ -155,8 +162,11 @@ hce_launch_checks(int fd, short event, void *arg)
 		if (table->conf.flags & F_DISABLE)
 			continue;
 		if (table->conf.skip_cnt) {
-			if (table->skipped++ > table->conf.skip_cnt)
-				table->skipped = 0;
+			/* advance the skip counter once per full sweep */
+			if (hce_slot == 0) {
+				if (table->skipped++ > table->conf.skip_cnt)
+					table->skipped = 0;
+			}
 			if (table->skipped != 1)
 				continue;
 		}
@@ -166,6 +176,8 @@ hce_launch_checks(int fd, short event, void *arg)
 		TAILQ_FOREACH(host, &table->hosts, entry) {
 			if (host->flags & F_DISABLE || host->conf.parentid)
 				continue;
+			if (host->conf.id % HCE_SLOTS != hce_slot)
+				continue;
 			bcopy(&tv, &host->cte.tv_start,
 			    sizeof(host->cte.tv_start));
 			switch (table->conf.check) {
@@ -187,7 +199,18 @@ hce_launch_checks(int fd, short event, void *arg)
 	}
 	check_icmp(env, &tv);
 
-	bcopy(&env->sc_conf.interval, &tv, sizeof(tv));
+	hce_slot = (hce_slot + 1) % HCE_SLOTS;
+
+	/*
+	 * Launch one slot of hosts per tick, so the checks are spread
+	 * evenly over the interval instead of going out in one storm;
+	 * each host is still checked once per interval.
+	 */
+	usec = (uint64_t)env->sc_conf.interval.tv_sec * 1000000 +
+	    env->sc_conf.interval.tv_usec;
+	usec /= HCE_SLOTS;
+	tv.tv_sec = usec / 1000000;
+	tv.tv_usec = usec % 1000000;
 	evtimer_add(&env->sc_ev, &tv);
 }
 
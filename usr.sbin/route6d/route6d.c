@@ -172,6 +172,7 @@ struct	sockaddr_storage ripsin;
 
 time_t	nextalarm = 0;
 time_t	sup_trig_update = 0;
+int	trig_pending = 0;	/* triggered update deferred by hold-down */
 
 static	int	seq = 0;
 
@@ -189,6 +190,7 @@ void sighandler(int);
 void ripalarm(void);
 void riprecv(void);
 void ripsend(struct ifc *, struct sockaddr_in6 *, int);
+void sendtrigger(struct ifc *);
 int out_filter(struct riprt *, struct ifc *);
 void init(void);
 void sockopt(struct ifc *);
@@ -242,8 +244,10 @@ main(int argc, char *argv[])
 {
 	int	ch;
 	int	error = 0;
+	int	timeout;
 	struct	ifc *ifcp;
 	sigset_t mask, omask;
+	time_t	t;
 	char *ep;
 
 	log_init(1); /* log to stderr until daemonized */
@@ -388,7 +392,16 @@ main(int argc, char *argv[])
 			continue;
 		}
 
-		switch (poll(pfd, 2, INFTIM))
+		if (trig_pending) {
+			/* wake up when the triggered update hold-down ends */
+			t = sup_trig_update - time(NULL);
+			if (t < 0)
+				t = 0;
+			timeout = t * 1000;
+		} else
+			timeout = INFTIM;
+
+		switch (poll(pfd, 2, timeout))
 		{
 		case -1:
 			if (errno != EINTR) {
@@ -397,7 +410,7 @@ main(int argc, char *argv[])
 			}
 			continue;
 		case 0:
-			continue;
+			break;
 		default:
 			if (pfd[0].revents & POLLIN) {
 				sigprocmask(SIG_BLOCK, &mask, &omask);
@@ -410,6 +423,9 @@ main(int argc, char *argv[])
 				sigprocmask(SIG_SETMASK, &omask, NULL);
 			}
 		}
+
+		if (trig_pending && time(NULL) >= sup_trig_update)
+			sendtrigger(NULL);
 	}
 }
 
@@ -498,6 +514,12 @@ ripalarm(void)
 		if (ifcp->ifc_index > 0 && (ifcp->ifc_flags & IFF_UP))
 			ripsend(ifcp, &ifcp->ifc_ripsin, 0);
 	}
+	/* the full update supersedes a pending triggered update */
+	if (trig_pending) {
+		for (rrt = riprt; rrt; rrt = rrt->rrt_next)
+			rrt->rrt_rflags &= ~RRTF_CHANGED;
+		trig_pending = 0;
+	}
 	alarm(ripinterval(SUPPLY_INTERVAL6));
 }
 
@@ -942,7 +964,7 @@ sendpacket(struct sockaddr_in6 *sin6, int len)
 void
 riprecv(void)
 {
-	struct	ifc *ifcp, *ic;
+	struct	ifc *ifcp;
 	struct	sockaddr_in6 fsock;
 	struct	in6_addr nh;	/* next hop */
 	struct	rip6 *rp;
@@ -1274,21 +1296,46 @@ riprecv(void)
 			rrt->rrt_t = t;
 		}
 	}
-	/* XXX need to care the interval between triggered updates */
+	/*
+	 * RFC 2080 2.5.1 requires a random interval between triggered
+	 * updates.  Within the hold-down the changed flags stay set, so
+	 * the changes accumulated meanwhile go out in a single batch
+	 * once it expires.
+	 */
 	if (need_trigger) {
-		if (nextalarm > time(NULL) + RIP_TRIG_INT6_MAX) {
-			for (ic = ifc; ic; ic = ic->ifc_next) {
-				if (ifcp->ifc_index == ic->ifc_index)
-					continue;
-				if (ic->ifc_flags & IFF_UP)
-					ripsend(ic, &ic->ifc_ripsin,
-						RRTF_CHANGED);
-			}
+		if (time(NULL) >= sup_trig_update)
+			sendtrigger(ifcp);
+		else
+			trig_pending = 1;
+	}
+}
+
+/*
+ * Send a triggered update on every interface except the one the change
+ * came in on, then arm the hold-down timer which suppresses further
+ * triggered updates for a random 1 to 5 seconds.  A NULL origin sends
+ * on all interfaces.
+ */
+void
+sendtrigger(struct ifc *origin)
+{
+	struct	ifc *ic;
+	struct	riprt *rrt;
+
+	/* skip the update if a regular update is imminent anyway */
+	if (nextalarm > time(NULL) + RIP_TRIG_INT6_MAX) {
+		for (ic = ifc; ic; ic = ic->ifc_next) {
+			if (origin && origin->ifc_index == ic->ifc_index)
+				continue;
+			if (ic->ifc_flags & IFF_UP)
+				ripsend(ic, &ic->ifc_ripsin, RRTF_CHANGED);
 		}
-		/* Reset the flag */
-		for (rrt = riprt; rrt; rrt = rrt->rrt_next)
-			rrt->rrt_rflags &= ~RRTF_CHANGED;
 	}
+	/* Reset the flag */
+	for (rrt = riprt; rrt; rrt = rrt->rrt_next)
+		rrt->rrt_rflags &= ~RRTF_CHANGED;
+	trig_pending = 0;
+	ripsuptrig();
 }
 
 /*
@@ -1508,12 +1555,11 @@ rtrecv(void)
 	struct ifa_msghdr *ifam;
 	struct if_msghdr *ifm;
 	int len;
-	struct ifc *ifcp, *ic;
+	struct ifc *ifcp;
 	int iface = 0, rtable = 0;
 	struct sockaddr_in6 *rta[RTAX_MAX];
 	struct sockaddr_in6 mask;
 	int i, addrs;
-	struct riprt *rrt;
 
 	if ((len = read(rtsock, buf, sizeof(buf))) == -1) {
 		perror("read from rtsock");
@@ -1697,16 +1743,10 @@ rtrecv(void)
 		for (ifcp = ifc; ifcp; ifcp = ifcp->ifc_next)
 			if (ifcp->ifc_cflags & IFC_CHANGED) {
 				if (ifrt(ifcp, 1)) {
-					for (ic = ifc; ic; ic = ic->ifc_next) {
-						if (ifcp->ifc_index == ic->ifc_index)
-							continue;
-						if (ic->ifc_flags & IFF_UP)
-							ripsend(ic, &ic->ifc_ripsin,
-							RRTF_CHANGED);
-					}
-					/* Reset the flag */
-					for (rrt = riprt; rrt; rrt = rrt->rrt_next)
-						rrt->rrt_rflags &= ~RRTF_CHANGED;
+					if (time(NULL) >= sup_trig_update)
+						sendtrigger(ifcp);
+					else
+						trig_pending = 1;
 				}
 				ifcp->ifc_cflags &= ~IFC_CHANGED;
 			}
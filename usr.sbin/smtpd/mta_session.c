@@ -804,19 +804,29 @@ again:
 		if (s->currevp == NULL)
 			s->currevp = TAILQ_FIRST(&s->task->envelopes);
 
+		/*
+		 * With PIPELINING, stream all RCPT commands at once and
+		 * collect the responses as they come in, instead of one
+		 * round trip per recipient.
+		 */
 		e = s->currevp;
-		if (s->ext & MTA_EXT_DSN) {
-			mta_send(s, "RCPT TO:<%s>%s%s%s%s",
-			    e->dest,
-			    e->dsn_notify ? " NOTIFY=" : "",
-			    e->dsn_notify ? dsn_strnotify(e->dsn_notify) : "",
-			    e->dsn_orcpt ? " ORCPT=" : "",
-			    e->dsn_orcpt ? e->dsn_orcpt : "");
-		} else
-			mta_send(s, "RCPT TO:<%s>", e->dest);
-
-		mta_report_tx_envelope(s, s->task->msgid, e->id);
-		s->rcptcount++;
+		while (e != NULL) {
+			if (s->ext & MTA_EXT_DSN) {
+				mta_send(s, "RCPT TO:<%s>%s%s%s%s",
+				    e->dest,
+				    e->dsn_notify ? " NOTIFY=" : "",
+				    e->dsn_notify ? dsn_strnotify(e->dsn_notify) : "",
+				    e->dsn_orcpt ? " ORCPT=" : "",
+				    e->dsn_orcpt ? e->dsn_orcpt : "");
+			} else
+				mta_send(s, "RCPT TO:<%s>", e->dest);
+
+			mta_report_tx_envelope(s, s->task->msgid, e->id);
+			s->rcptcount++;
+			if (!(s->ext & MTA_EXT_PIPELINING))
+				break;
+			e = TAILQ_NEXT(e, entry);
+		}
 		break;
 
 	case MTA_DATA:
@@ -1073,7 +1083,13 @@ mta_response(struct mta_session *s, char *line)
 				mta_hoststat_update(domain, e->status);
 			mta_delivery_notify(e);
 
-			if (s->relay->limits->max_failures_per_session &&
+			/*
+			 * When pipelining, responses for the other RCPT
+			 * commands are still on the way; bailing out is
+			 * deferred until they have all been collected.
+			 */
+			if (!(s->ext & MTA_EXT_PIPELINING) &&
+			    s->relay->limits->max_failures_per_session &&
 			    s->failures == s->relay->limits->max_failures_per_session) {
 					mta_flush_task(s, IMSG_MTA_DELIVERY_TEMPFAIL,
 					    "Too many consecutive errors, closing connection", 0, 1);
@@ -1107,9 +1123,18 @@ mta_response(struct mta_session *s, char *line)
 			break;
 		}
 
-		if (s->currevp == NULL)
+		if (s->currevp == NULL) {
+			if ((s->ext & MTA_EXT_PIPELINING) &&
+			    s->relay->limits->max_failures_per_session &&
+			    s->failures >=
+			    s->relay->limits->max_failures_per_session) {
+				mta_flush_task(s, IMSG_MTA_DELIVERY_TEMPFAIL,
+				    "Too many consecutive errors, closing connection", 0, 1);
+				mta_enter_state(s, MTA_QUIT);
+				break;
+			}
 			mta_enter_state(s, MTA_DATA);
-		else
+		} else if (!(s->ext & MTA_EXT_PIPELINING))
 			mta_enter_state(s, MTA_RCPT);
 		break;
 
@@ -42,6 +42,7 @@
 
 int	dblist(DB *);
 int	dbupdate(DB *, char *, int, int);
+int	dbdelete_grey(DB *, char **, int);
 
 int
 dbupdate(DB *db, char *ip, int add, int type)
@@ -70,23 +71,10 @@ dbupdate(DB *db, char *ip, int add, int type)
 	memset(&dbd, 0, sizeof(dbd));
 	if (!add) {
 		/* remove entry */
-		if (type == GREY) {
-			for (r = db->seq(db, &dbk, &dbd, R_FIRST); !r;
-			    r = db->seq(db, &dbk, &dbd, R_NEXT)) {
-				char *cp = memchr(dbk.data, '\n', dbk.size);
-				if (cp != NULL) {
-					size_t len = cp - (char *)dbk.data;
-					if (memcmp(ip, dbk.data, len) == 0 &&
-					    ip[len] == '\0')
-						break;
-				}
-			}
-		} else {
-			r = db->get(db, &dbk, &dbd, 0);
-			if (r == -1) {
-				warn("db->get failed");
-				goto bad;
-			}
+		r = db->get(db, &dbk, &dbd, 0);
+		if (r == -1) {
+			warn("db->get failed");
+			goto bad;
 		}
 		if (r) {
 			warnx("no entry for %s", ip);
@@ -185,6 +173,67 @@ dbupdate(DB *db, char *ip, int add, int type)
 	return (1);
 }
 
+int
+dbdelete_grey(DB *db, char **addrs, int naddrs)
+{
+	DBT		 dbk, dbd;
+	DBT		*keys;
+	int		*found;
+	size_t		 len;
+	char		*cp;
+	int		 i, r, errors = 0;
+
+	if ((keys = calloc(naddrs, sizeof(*keys))) == NULL ||
+	    (found = calloc(naddrs, sizeof(*found))) == NULL)
+		err(1, "calloc");
+
+	/*
+	 * Grey entries are keyed by "ip\nhelo\nfrom\nto", so a delete
+	 * by ip has to look at every entry.  Walk the database once for
+	 * all addresses instead of once per address, remember the keys
+	 * that matched and delete them when the cursor is done.
+	 */
+	memset(&dbk, 0, sizeof(dbk));
+	memset(&dbd, 0, sizeof(dbd));
+	for (r = db->seq(db, &dbk, &dbd, R_FIRST); !r;
+	    r = db->seq(db, &dbk, &dbd, R_NEXT)) {
+		cp = memchr(dbk.data, '\n', dbk.size);
+		if (cp == NULL)
+			continue;
+		len = cp - (char *)dbk.data;
+		for (i = 0; i < naddrs; i++) {
+			if (found[i] || addrs[i][0] == '\0')
+				continue;
+			if (strlen(addrs[i]) == len &&
+			    memcmp(addrs[i], dbk.data, len) == 0)
+				break;
+		}
+		if (i == naddrs)
+			continue;
+		found[i] = 1;
+		keys[i].size = dbk.size;
+		if ((keys[i].data = malloc(dbk.size)) == NULL)
+			err(1, "malloc");
+		memcpy(keys[i].data, dbk.data, dbk.size);
+	}
+
+	for (i = 0; i < naddrs; i++) {
+		if (addrs[i][0] == '\0')
+			continue;
+		if (!found[i]) {
+			warnx("no entry for %s", addrs[i]);
+			errors++;
+		} else if (db->del(db, &keys[i], 0)) {
+			warn("db->del failed");
+			errors++;
+		}
+		free(keys[i].data);
+	}
+	free(keys);
+	free(found);
+	return (errors);
+}
+
 int
 print_entry(DBT *dbk, DBT *dbd)
 {
@@ -390,12 +439,16 @@ main(int argc, char **argv)
 		break;
 	case 2:
 		for (i=0; i<argc; i++)
-			if (argv[i][0] != '\0') {
+			if (argv[i][0] != '\0')
 				c++;
-				r += dbupdate(db, argv[i], 0, type);
-			}
 		if (c == 0)
 			errx(2, "no addresses specified");
+		if (type == GREY)
+			r = dbdelete_grey(db, argv, argc);
+		else
+			for (i=0; i<argc; i++)
+				if (argv[i][0] != '\0')
+					r += dbupdate(db, argv[i], 0, type);
 		break;
 	default:
 		errx(-1, "bad action");
@@ -74,6 +74,8 @@
 #define MAX_MEMBUF	(256 * 1024)	/* Maximum memory buffer size */
 #define MAX_MEMBUF_NAME	64		/* Max length of membuf log name */
 #define MAX_TCPBUF	(256 * 1024)	/* Maximum tcp event buffer size */
+#define MAX_FILEBUF	(64 * 1024)	/* Flush file buffer beyond this size */
+#define RECV_BATCH	32		/* Datagrams received per syscall */
 #define	MAXSVLINE	120		/* maximum saved line length */
 #define FD_RESERVE	5		/* file descriptors not accepted */
 #define DEFUPRI		(LOG_USER|LOG_NOTICE)
@@ -182,6 +184,7 @@ struct filed {
 	int	f_quick;			/* abort when matched */
 	int	f_dropped;			/* warn, dropped message */
 	time_t	f_lasterrtime;			/* last error was reported */
+	struct evbuffer *f_filebuf;		/* batched output for files */
 };
 
 /*
@@ -292,9 +295,11 @@ size_t	ctl_reply_offset = 0;	/* Number of bytes of reply written so far */
 
 char	*linebuf;
 int	 linesize;
+char	*recvbuf;		/* RECV_BATCH lines for recvmmsg() */
 
 int		 fd_ctlconn, fd_udp, fd_udp6, send_udp, send_udp6;
 struct event	*ev_ctlaccept, *ev_ctlread, *ev_ctlwrite;
+struct event	 ev_fileflush;
 
 struct peer {
 	struct buffertls	 p_buftls;
@@ -329,6 +334,7 @@ void	 udp_resolvecb(int, short, void *);
 int	 tcpbuf_countmsg(struct bufferevent *bufev);
 void	 die_signalcb(int, short, void *);
 void	 mark_timercb(int, short, void *);
+void	 fileflush_timercb(int, short, void *);
 void	 init_signalcb(int, short, void *);
 void	 ctlsock_acceptcb(int, short, void *);
 void	 ctlconn_readcb(int, short, void *);
@@ -341,6 +347,7 @@ void	cvthname(struct sockaddr *, char *, size_t);
 int	decode(const char *, const CODE *);
 void	markit(void);
 void	fprintlog(struct filed *, int, char *);
+void	filed_flush(struct filed *, int);
 void	dropped_warn(int *, const char *);
 void	init(void);
 void	logevent(int, const char *);
@@ -525,6 +532,8 @@ main(int argc, char *argv[])
 	linesize++;
 	if ((linebuf = malloc(linesize)) == NULL)
 		fatal("allocate line buffer");
+	if ((recvbuf = reallocarray(NULL, RECV_BATCH, LOG_MAXLINE + 1)) == NULL)
+		fatal("allocate receive buffer");
 
 	if (socket_bind("udp", NULL, "syslog", SecureMode,
 	    &fd_udp, &fd_udp6) == -1)
@@ -820,6 +829,7 @@ main(int argc, char *argv[])
 	signal_set(ev_term, SIGTERM, die_signalcb, ev_term);
 
 	evtimer_set(ev_mark, mark_timercb, ev_mark);
+	evtimer_set(&ev_fileflush, fileflush_timercb, NULL);
 
 	init();
 
@@ -1045,39 +1055,66 @@ klog_readcb(int fd, short event, void *arg)
 void
 udp_readcb(int fd, short event, void *arg)
 {
-	struct sockaddr_storage	 sa;
-	socklen_t		 salen;
-	ssize_t			 n;
-
-	salen = sizeof(sa);
-	n = recvfrom(fd, linebuf, LOG_MAXLINE, 0, (struct sockaddr *)&sa,
-	    &salen);
-	if (n > 0) {
-		char	 resolve[NI_MAXHOST];
-
-		linebuf[n] = '\0';
-		cvthname((struct sockaddr *)&sa, resolve, sizeof(resolve));
+	struct mmsghdr		 msgvec[RECV_BATCH];
+	struct iovec		 iov[RECV_BATCH];
+	struct sockaddr_storage	 sa[RECV_BATCH];
+	char			 resolve[NI_MAXHOST];
+	char			*line;
+	int			 i, n;
+
+	memset(msgvec, 0, sizeof(msgvec));
+	for (i = 0; i < RECV_BATCH; i++) {
+		iov[i].iov_base = recvbuf + i * (LOG_MAXLINE + 1);
+		iov[i].iov_len = LOG_MAXLINE;
+		msgvec[i].msg_hdr.msg_iov = &iov[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+		msgvec[i].msg_hdr.msg_name = &sa[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(sa[i]);
+	}
+	n = recvmmsg(fd, msgvec, RECV_BATCH, 0, NULL);
+	if (n == -1) {
+		if (errno != EINTR && errno != EWOULDBLOCK)
+			log_warn("recvmmsg udp");
+		return;
+	}
+	for (i = 0; i < n; i++) {
+		line = iov[i].iov_base;
+		line[msgvec[i].msg_len] = '\0';
+		cvthname((struct sockaddr *)&sa[i], resolve, sizeof(resolve));
 		log_debug("cvthname res: %s", resolve);
-		printline(resolve, linebuf);
-	} else if (n == -1 && errno != EINTR && errno != EWOULDBLOCK)
-		log_warn("recvfrom udp");
+		printline(resolve, line);
+	}
 }
 
 void
 unix_readcb(int fd, short event, void *arg)
 {
-	struct sockaddr_un	 sa;
-	socklen_t		 salen;
-	ssize_t			 n;
-
-	salen = sizeof(sa);
-	n = recvfrom(fd, linebuf, LOG_MAXLINE, 0, (struct sockaddr *)&sa,
-	    &salen);
-	if (n > 0) {
-		linebuf[n] = '\0';
-		printline(LocalHostName, linebuf);
-	} else if (n == -1 && errno != EINTR && errno != EWOULDBLOCK)
-		log_warn("recvfrom unix");
+	struct mmsghdr		 msgvec[RECV_BATCH];
+	struct iovec		 iov[RECV_BATCH];
+	struct sockaddr_un	 sa[RECV_BATCH];
+	char			*line;
+	int			 i, n;
+
+	memset(msgvec, 0, sizeof(msgvec));
+	for (i = 0; i < RECV_BATCH; i++) {
+		iov[i].iov_base = recvbuf + i * (LOG_MAXLINE + 1);
+		iov[i].iov_len = LOG_MAXLINE;
+		msgvec[i].msg_hdr.msg_iov = &iov[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+		msgvec[i].msg_hdr.msg_name = &sa[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(sa[i]);
+	}
+	n = recvmmsg(fd, msgvec, RECV_BATCH, 0, NULL);
+	if (n == -1) {
+		if (errno != EINTR && errno != EWOULDBLOCK)
+			log_warn("recvmmsg unix");
+		return;
+	}
+	for (i = 0; i < n; i++) {
+		line = iov[i].iov_base;
+		line[msgvec[i].msg_len] = '\0';
+		printline(LocalHostName, line);
+	}
 }
 
 int
@@ -2115,6 +2152,30 @@ fprintlog(struct filed *f, int flags, char *msg)
 	case F_FILE:
 	case F_PIPE:
 		log_debug(" %s", f->f_un.f_fname);
+		if (f->f_type == F_FILE && f->f_filebuf != NULL) {
+			struct timeval to = { 1, 0 };
+
+			if (evbuffer_add_printf(f->f_filebuf,
+			    "%s%s%s%s%s%s%s", (char *)iov[0].iov_base,
+			    (char *)iov[1].iov_base, (char *)iov[2].iov_base,
+			    (char *)iov[3].iov_base, (char *)iov[4].iov_base,
+			    (char *)iov[5].iov_base,
+			    (char *)iov[6].iov_base) == -1) {
+				f->f_dropped++;
+				break;
+			}
+			/*
+			 * Write urgent messages and big buffers at once,
+			 * batch the rest until the flush timer fires.
+			 */
+			if ((flags & SYNC_FILE) ||
+			    LOG_PRI(f->f_prevpri) <= LOG_ERR ||
+			    EVBUFFER_LENGTH(f->f_filebuf) >= MAX_FILEBUF)
+				filed_flush(f, flags);
+			else if (!evtimer_pending(&ev_fileflush, NULL))
+				evtimer_add(&ev_fileflush, &to);
+			break;
+		}
 		retryonce = 0;
 	again:
 		if (writev(f->f_file, iov, IOVCNT) == -1) {
@@ -2217,6 +2278,68 @@ fprintlog(struct filed *f, int flags, char *msg)
 	f->f_prevcount = 0;
 }
 
+/*
+ * Write the batched output of a file log target.
+ */
+void
+filed_flush(struct filed *f, int flags)
+{
+	char ebuf[ERRBUFSIZE];
+	size_t i, len;
+	ssize_t n;
+
+	if (f->f_type != F_FILE || f->f_filebuf == NULL)
+		return;
+
+	while ((len = EVBUFFER_LENGTH(f->f_filebuf)) > 0) {
+		if ((n = write(f->f_file, EVBUFFER_DATA(f->f_filebuf),
+		    len)) == -1) {
+			int e = errno;
+
+			/* allow to recover from file system full */
+			if (e == ENOSPC) {
+				if (f->f_dropped == 0) {
+					f->f_type = F_UNUSED;
+					errno = e;
+					log_warn("write to file \"%s\"",
+					    f->f_un.f_fname);
+					f->f_type = F_FILE;
+				}
+				for (i = 0; i < len; i++)
+					if (EVBUFFER_DATA(f->f_filebuf)[i] ==
+					    '\n')
+						f->f_dropped++;
+				evbuffer_drain(f->f_filebuf, len);
+				return;
+			}
+
+			(void)close(f->f_file);
+			f->f_type = F_UNUSED;
+			f->f_file = -1;
+			errno = e;
+			log_warn("write \"%s\"", f->f_un.f_fname);
+			return;
+		}
+		evbuffer_drain(f->f_filebuf, n);
+	}
+	if (flags & SYNC_FILE)
+		(void)fsync(f->f_file);
+	if (f->f_dropped > 0) {
+		snprintf(ebuf, sizeof(ebuf), "to file \"%s\"",
+		    f->f_un.f_fname);
+		dropped_warn(&f->f_dropped, ebuf);
+	}
+}
+
+void
+fileflush_timercb(int fd, short event, void *arg)
+{
+	struct filed *f;
+
+	SIMPLEQ_FOREACH(f, &Files, f_next)
+		filed_flush(f, 0);
+}
+
 /*
  *  WALLMSG -- Write a message to the world at large
  *
@@ -2358,6 +2481,7 @@ die(int signo)
 			f->f_dropped = 0;
 		}
 		if (f->f_type == F_FILE) {
+			filed_flush(f, 0);
 			file_dropped += f->f_dropped;
 			f->f_dropped = 0;
 		}
@@ -2436,8 +2560,14 @@ init(void)
 			free(f->f_un.f_forw.f_port);
 			/* FALLTHROUGH */
 		case F_FILE:
-			if (f->f_type == F_FILE)
+			if (f->f_type == F_FILE) {
+				filed_flush(f, 0);
+				if (f->f_filebuf != NULL) {
+					evbuffer_free(f->f_filebuf);
+					f->f_filebuf = NULL;
+				}
 				file_dropped += f->f_dropped;
+			}
 			f->f_dropped = 0;
 			/* FALLTHROUGH */
 		case F_TTY:
@@ -2930,6 +3060,10 @@ cfline(char *line, char *progblock, char *hostblock)
 					i &= ~O_NONBLOCK;
 					fcntl(f->f_file, F_SETFL, i);
 				}
+
+				/* Batch writes, fall back to writev() */
+				if ((f->f_filebuf = evbuffer_new()) == NULL)
+					log_warn("evbuffer file \"%s\"", p);
 			}
 		}
 		break;
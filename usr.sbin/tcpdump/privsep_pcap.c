@@ -46,6 +46,9 @@
 
 #include "privsep.h"
 
+/* stdio buffer size for savefile input and output */
+#define PCAP_FILEBUF	(1024 * 1024)
+
 /*
  * privileged part of priv_pcap_setfilter, compile the filter
  * expression, and return it to the parent. Note that we fake an hpcap
@@ -185,11 +188,23 @@ pcap_live(const char *device, int snaplen, int promisc, u_int dlt,
 	if ((fd = open("/dev/bpf", O_RDONLY)) == -1)
 		return (-1);
 
-	v = 32768;	/* XXX this should be a user-accessible hook */
-	ioctl(fd, BIOCSBLEN, &v);
-
 	strlcpy(ifr.ifr_name, device, sizeof(ifr.ifr_name));
-	if (ioctl(fd, BIOCSETIF, &ifr) == -1)
+
+	/*
+	 * Ask for the largest buffer the kernel will give us; BIOCSBLEN
+	 * clamps the size to net.bpf.maxbufsize.  The buffers are only
+	 * allocated when the descriptor is attached to the interface, so
+	 * retry with smaller sizes if the kernel is short on memory.
+	 * The old hardcoded 32k default drops packets on loaded links.
+	 */
+	for (v = BPF_MAXBUFSIZE; v >= 32768; v >>= 1) {
+		ioctl(fd, BIOCSBLEN, &v);
+		if (ioctl(fd, BIOCSETIF, &ifr) == 0)
+			break;
+		if (errno != ENOMEM && errno != ENOBUFS)
+			goto error;
+	}
+	if (v < 32768)
 		goto error;
 
 	if (dlt != (u_int) -1 && ioctl(fd, BIOCSDLT, &dlt) == -1)
@@ -383,6 +398,13 @@ priv_pcap_offline(const char *fname, char *errbuf)
 			p->fd = -1;
 			goto bad;
 		}
+
+		/*
+		 * Scanning a large savefile pulls one packet at a time out
+		 * of stdio; a buffer much larger than st_blksize keeps the
+		 * read(2) count down.
+		 */
+		(void)setvbuf(fp, NULL, _IOFBF, PCAP_FILEBUF);
 	}
 	if (fread((char *)&hdr, sizeof(hdr), 1, fp) != 1) {
 		snprintf(errbuf, PCAP_ERRBUF_SIZE, "fread: %s",
@@ -502,6 +524,9 @@ priv_pcap_dump_open(pcap_t *p, char *fname)
 			close(fd);
 			return (NULL);
 		}
+
+		/* Batch packet writes into fewer, larger write(2) calls. */
+		(void)setvbuf(f, NULL, _IOFBF, PCAP_FILEBUF);
 	}
 	priv_init_done();
 
@@ -55,6 +55,7 @@
 #include "util/tube.h"
 #include "util/timehist.h"
 #include "util/net_help.h"
+#include "util/regional.h"
 #include "validator/validator.h"
 #include "iterator/iterator.h"
 #include "sldns/sbuffer.h"
@@ -131,6 +132,9 @@ void server_stats_log(struct ub_server_stats* stats, struct worker* worker,
 			stats->num_queries_prefetch) : 0.0,
 		(unsigned)worker->env.mesh->stats_dropped,
 		(unsigned)worker->env.mesh->stats_jostled);
+	log_info("server stats for thread %d: scratchpad fallback "
+		"allocations %u", threadnum,
+		(unsigned)regional_get_malloc_count(worker->scratchpad));
 }
 
 
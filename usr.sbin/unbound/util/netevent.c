@@ -114,6 +114,11 @@
 #define NUM_UDP_PER_SELECT 1
 #endif
 
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+/** number of datagrams to pass to the kernel per recvmmsg/sendmmsg call */
+#define UDP_MSG_BATCH 16
+#endif
+
 /** timeout in millisec to wait for write to unblock, packets dropped after.*/
 #define SEND_BLOCKED_WAIT_TIMEOUT 200
 /** max number of times to wait for write to unblock, packets dropped after.*/
@@ -140,6 +145,30 @@ struct internal_event {
 	struct ub_event* ev;
 };
 
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+/**
+ * Scratch space for batched UDP I/O, shared by the UDP comm points of
+ * one thread and allocated on first use.  Holds the msg headers for a
+ * recvmmsg burst and the replies queued for one sendmmsg call.
+ */
+struct udp_msg_batch {
+	/** receive side msg headers, one per datagram in the burst */
+	struct mmsghdr recv_msgs[UDP_MSG_BATCH];
+	/** receive side iovecs, each pointing at one payload slot */
+	struct iovec recv_iov[UDP_MSG_BATCH];
+	/** source addresses of the received datagrams */
+	struct sockaddr_storage recv_addr[UDP_MSG_BATCH];
+	/** send side msg headers for the immediate replies of a burst */
+	struct mmsghdr send_msgs[UDP_MSG_BATCH];
+	/** send side iovecs, pointing into the payload slots */
+	struct iovec send_iov[UDP_MSG_BATCH];
+	/** payload area, UDP_MSG_BATCH slots of bufsize bytes each */
+	uint8_t* pkts;
+	/** size of one payload slot */
+	size_t bufsize;
+};
+#endif /* HAVE_RECVMMSG && HAVE_SENDMMSG */
+
 /**
  * Internal base structure, so that every thread has its own events.
  */
@@ -158,6 +187,10 @@ struct internal_base {
 	time_t last_slow_log;
 	/** last log time for slow logging of write wait failures */
 	time_t last_writewait_log;
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+	/** batch scratch for UDP I/O, NULL until first UDP burst */
+	struct udp_msg_batch* udp_batch;
+#endif
 };
 
 /**
@@ -248,6 +281,12 @@ comm_base_delete(struct comm_base* b)
 	}
 	ub_event_base_free(b->eb->base);
 	b->eb->base = NULL;
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+	if(b->eb->udp_batch) {
+		free(b->eb->udp_batch->pkts);
+		free(b->eb->udp_batch);
+	}
+#endif
 	free(b->eb);
 	free(b);
 }
@@ -264,6 +303,12 @@ comm_base_delete_no_base(struct comm_base* b)
 		ub_event_free(b->eb->slow_accept);
 	}
 	b->eb->base = NULL;
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+	if(b->eb->udp_batch) {
+		free(b->eb->udp_batch->pkts);
+		free(b->eb->udp_batch);
+	}
+#endif
 	free(b->eb);
 	free(b);
 }
@@ -1079,6 +1124,161 @@ comm_point_udp_ancil_callback(int fd, short event, void* arg)
 #endif /* AF_INET6 && IPV6_PKTINFO && HAVE_RECVMSG */
 }
 
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+/** get the thread's UDP batch scratch, sized for bufsize payload slots,
+ * allocate or grow it as needed, or return NULL on malloc failure. */
+static struct udp_msg_batch*
+udp_batch_get(struct comm_base* base, size_t bufsize)
+{
+	struct udp_msg_batch* b = base->eb->udp_batch;
+	uint8_t* pkts;
+	if(b && b->bufsize >= bufsize)
+		return b;
+	if(!b) {
+		b = (struct udp_msg_batch*)calloc(1, sizeof(*b));
+		if(!b)
+			return NULL;
+		base->eb->udp_batch = b;
+	}
+	pkts = (uint8_t*)realloc(b->pkts, (size_t)UDP_MSG_BATCH*bufsize);
+	if(!pkts)
+		return NULL;
+	b->pkts = pkts;
+	b->bufsize = bufsize;
+	return b;
+}
+
+/** transmit the queued immediate replies of a burst with sendmmsg.
+ * Datagrams the kernel did not take are handed to the single packet
+ * send routine, which waits for the socket to become writable. */
+static void
+udp_batch_send(int fd, struct comm_point* c, struct udp_msg_batch* b,
+	int nsend)
+{
+	struct sldns_buffer pkt;
+	int i = 0, s;
+	while(i < nsend) {
+		s = sendmmsg(fd, &b->send_msgs[i], (unsigned int)(nsend-i),
+			0);
+		if(s <= 0)
+			break;
+		i += s;
+	}
+	for(; i < nsend; i++) {
+		if(!c || c->fd != fd)
+			break; /* commpoint closed during the burst */
+		sldns_buffer_init_frm_data(&pkt,
+			b->send_iov[i].iov_base, b->send_iov[i].iov_len);
+		(void)comm_point_send_udp_msg(c, &pkt,
+			(struct sockaddr*)b->send_msgs[i].msg_hdr.msg_name,
+			b->send_msgs[i].msg_hdr.msg_namelen, 0);
+	}
+}
+
+/** drain a readable UDP socket with recvmmsg and process the burst,
+ * collecting immediate replies for one sendmmsg call per burst. */
+static void
+comm_point_udp_batch_callback(int fd, struct comm_reply* rep,
+	struct udp_msg_batch* b)
+{
+	struct sldns_buffer pkt, *saved = rep->c->buffer;
+	int i, n, nsend, total = 0;
+
+	while(total < NUM_UDP_PER_SELECT) {
+		for(i=0; i<UDP_MSG_BATCH; i++) {
+			b->recv_iov[i].iov_base = b->pkts +
+				(size_t)i*b->bufsize;
+			b->recv_iov[i].iov_len = b->bufsize;
+			memset(&b->recv_msgs[i].msg_hdr, 0,
+				sizeof(b->recv_msgs[i].msg_hdr));
+			b->recv_msgs[i].msg_hdr.msg_name = &b->recv_addr[i];
+			b->recv_msgs[i].msg_hdr.msg_namelen =
+				(socklen_t)sizeof(b->recv_addr[i]);
+			b->recv_msgs[i].msg_hdr.msg_iov = &b->recv_iov[i];
+			b->recv_msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		n = recvmmsg(fd, b->recv_msgs, UDP_MSG_BATCH, MSG_DONTWAIT,
+			NULL);
+		if(n <= 0) {
+			if(n == -1 && errno != EAGAIN && errno != EINTR
+				&& udp_recv_needs_log(errno))
+				log_err("recvmmsg %d failed: %s", fd,
+					strerror(errno));
+			return;
+		}
+		total += n;
+		nsend = 0;
+		for(i=0; i<n; i++) {
+			sldns_buffer_init_frm_data(&pkt,
+				b->recv_iov[i].iov_base, b->bufsize);
+			sldns_buffer_set_limit(&pkt, b->recv_msgs[i].msg_len);
+			rep->remote_addrlen =
+				b->recv_msgs[i].msg_hdr.msg_namelen;
+			memmove(&rep->remote_addr, &b->recv_addr[i],
+				rep->remote_addrlen);
+			rep->srctype = 0;
+			rep->is_proxied = 0;
+
+			if(rep->c->pp2_enabled && !consume_pp2_header(&pkt,
+				rep, 0)) {
+				log_err("proxy_protocol: could not consume "
+					"PROXYv2 header");
+				continue;
+			}
+			if(!rep->is_proxied) {
+				rep->client_addrlen = rep->remote_addrlen;
+				memmove(&rep->client_addr, &rep->remote_addr,
+					rep->remote_addrlen);
+			}
+
+			/* process this packet, and build an immediate reply,
+			 * in its payload slot; the slot stays untouched for
+			 * the rest of the burst so replies can be batched */
+			rep->c->buffer = &pkt;
+			fptr_ok(fptr_whitelist_comm_point(rep->c->callback));
+			if((*rep->c->callback)(rep->c, rep->c->cb_arg,
+				NETEVENT_NOERROR, rep)) {
+#ifdef USE_DNSCRYPT
+				/* the encrypted reply lives in a shared
+				 * buffer, send it before the next packet
+				 * overwrites it */
+				(void)comm_point_send_udp_msg(rep->c,
+					rep->c->dnscrypt_buffer,
+					(struct sockaddr*)&rep->remote_addr,
+					rep->remote_addrlen, 0);
+#else
+				b->send_iov[nsend].iov_base =
+					sldns_buffer_begin(&pkt);
+				b->send_iov[nsend].iov_len =
+					sldns_buffer_remaining(&pkt);
+				memset(&b->send_msgs[nsend].msg_hdr, 0,
+					sizeof(b->send_msgs[nsend].msg_hdr));
+				b->send_msgs[nsend].msg_hdr.msg_name =
+					&b->recv_addr[i];
+				b->send_msgs[nsend].msg_hdr.msg_namelen =
+					rep->remote_addrlen;
+				b->send_msgs[nsend].msg_hdr.msg_iov =
+					&b->send_iov[nsend];
+				b->send_msgs[nsend].msg_hdr.msg_iovlen = 1;
+				nsend++;
+#endif
+			}
+			if(rep->c)
+				rep->c->buffer = saved;
+			if(!rep->c || rep->c->fd != fd) {
+				/* commpoint closed to -1 or reused for
+				 * another UDP port */
+				udp_batch_send(fd, rep->c, b, nsend);
+				return;
+			}
+		}
+		udp_batch_send(fd, rep->c, b, nsend);
+		if(n < UDP_MSG_BATCH)
+			return; /* socket drained */
+	}
+}
+#endif /* HAVE_RECVMMSG && HAVE_SENDMMSG */
+
 void
 comm_point_udp_callback(int fd, short event, void* arg)
 {
@@ -1094,6 +1294,17 @@ comm_point_udp_callback(int fd, short event, void* arg)
 		return;
 	log_assert(rep.c && rep.c->buffer && rep.c->fd == fd);
 	ub_comm_base_now(rep.c->ev->base);
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+	{
+		struct udp_msg_batch* b = udp_batch_get(rep.c->ev->base,
+			sldns_buffer_capacity(rep.c->buffer));
+		if(b) {
+			comm_point_udp_batch_callback(fd, &rep, b);
+			return;
+		}
+		/* else fall back to single packet I/O */
+	}
+#endif
 	for(i=0; i<NUM_UDP_PER_SELECT; i++) {
 		sldns_buffer_clear(rep.c->buffer);
 		rep.remote_addrlen = (socklen_t)sizeof(rep.remote_addr);
@@ -96,6 +96,7 @@ regional_create_custom_large_object(size_t size, size_t large_object_size)
 	if(!r) return NULL;
 	r->first_size = size;
 	r->large_object_size = large_object_size;
+	r->malloc_count = 0;
 	regional_init(r);
 	return r;
 }
@@ -160,6 +161,7 @@ regional_alloc(struct regional *r, size_t size)
 	if(a > r->large_object_size) {
 		s = malloc(ALIGNMENT + size);
 		if(!s) return NULL;
+		r->malloc_count++;
 		r->total_large += ALIGNMENT+size;
 		*(char**)s = r->large_list;
 		r->large_list = (char*)s;
@@ -169,6 +171,7 @@ regional_alloc(struct regional *r, size_t size)
 	if(a > r->available) {
 		s = malloc(REGIONAL_CHUNK_SIZE);
 		if(!s) return NULL;
+		r->malloc_count++;
 		*(char**)s = r->next;
 		r->next = (char*)s;
 		r->data = (char*)s + ALIGNMENT;
@@ -255,3 +258,9 @@ regional_get_mem(struct regional* r)
 	return r->first_size + (count_chunks(r)-1)*REGIONAL_CHUNK_SIZE 
 		+ r->total_large;
 }
+
+size_t
+regional_get_malloc_count(struct regional* r)
+{
+	return r->malloc_count;
+}
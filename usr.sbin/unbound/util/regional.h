@@ -76,6 +76,9 @@ struct regional
 	char* data;
 	/** threshold for outside of chunk allocations */
 	size_t large_object_size;
+	/** cumulative number of chunk and large object mallocs performed
+	 * on behalf of this region; not reset by regional_free_all. */
+	size_t malloc_count;
 	/** padding for sizeof8 alignment of sizeof(struct regional)
 	 * for 32bit systems */
 	size_t padding;
@@ -160,4 +163,7 @@ void regional_log_stats(struct regional *r);
 /** get total memory size in use by region */
 size_t regional_get_mem(struct regional* r);
 
+/** get cumulative number of mallocs performed on behalf of region */
+size_t regional_get_malloc_count(struct regional* r);
+
 #endif /* UTIL_REGIONAL_H_ */
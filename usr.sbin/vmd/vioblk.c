@@ -26,6 +26,8 @@
 #include <errno.h>
 #include <event.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <pthread_np.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -42,16 +44,29 @@ struct iovec io_v[VIOBLK_QUEUE_SIZE];
 static const char *disk_type(int);
 static uint32_t handle_io_read(struct viodev_msg *, struct virtio_dev *,
     int8_t *);
-static int handle_io_write(struct viodev_msg *, struct virtio_dev *);
+static void handle_io_write(struct viodev_msg *, struct virtio_dev *);
 
 static void vioblk_update_qs(struct vioblk_dev *);
 static void vioblk_update_qa(struct vioblk_dev *);
-static int vioblk_notifyq(struct vioblk_dev *);
+static int vioblk_notifyq(struct virtio_dev *);
 static ssize_t vioblk_rw(struct vioblk_dev *, int, off_t,
     struct vring_desc *, struct vring_desc **);
 
+static void *io_run_loop(void *);
 static void dev_dispatch_vm(int, short, void *);
 static void handle_sync_io(int, short, void *);
+static void read_pipe_main(int, short, void *);
+static void read_pipe_io(int, short, void *);
+static void vioblk_assert_pic_irq(struct virtio_dev *);
+static void vioblk_deassert_pic_irq(struct virtio_dev *);
+
+/* Device Globals */
+static struct event_base *ev_base_main;
+static struct event_base *ev_base_io;
+static pthread_t io_thread;
+static struct vm_dev_pipe pipe_main;
+static struct vm_dev_pipe pipe_io;
+static pthread_rwlock_t lock = NULL;	/* Guards device config state. */
 
 static const char *
 disk_type(int type)
@@ -161,13 +176,38 @@ vioblk_main(int fd, int fd_vmm)
 	if (vm.vm_state & VM_STATE_RECEIVED)
 		vioblk_update_qa(vioblk);
 
+	/* Initialize inter-thread communication channels. */
+	vm_pipe_init2(&pipe_main, read_pipe_main, &dev);
+	vm_pipe_init2(&pipe_io, read_pipe_io, &dev);
+
+	/* Initialize the io thread that services virtqueue notifications. */
+	ret = pthread_create(&io_thread, NULL, io_run_loop, &dev);
+	if (ret) {
+		errno = ret;
+		log_warn("%s: failed to initialize io thread", __func__);
+		goto fail;
+	}
+	pthread_set_name_np(io_thread, "io");
+
+	/* Initialize our rwlock for guarding shared device state. */
+	ret = pthread_rwlock_init(&lock, NULL);
+	if (ret) {
+		errno = ret;
+		log_warn("%s: failed to initialize rwlock", __func__);
+		goto fail;
+	}
+
 	/* Initialize libevent so we can start wiring event handlers. */
-	event_init();
+	ev_base_main = event_base_new();
+
+	/* Add our handler for receiving messages from the io thread. */
+	event_base_set(ev_base_main, &pipe_main.read_ev);
+	event_add(&pipe_main.read_ev, NULL);
 
 	/* Wire up an async imsg channel. */
 	log_debug("%s: wiring in async vm event handler (fd=%d)", __func__,
 		dev.async_fd);
-	if (vm_device_pipe(&dev, dev_dispatch_vm, NULL)) {
+	if (vm_device_pipe(&dev, dev_dispatch_vm, ev_base_main)) {
 		ret = EIO;
 		log_warnx("vm_device_pipe");
 		goto fail;
@@ -180,31 +220,42 @@ vioblk_main(int fd, int fd_vmm)
 	dev.sync_iev.handler = handle_sync_io;
 	dev.sync_iev.data = &dev;
 	dev.sync_iev.events = EV_READ;
-	imsg_event_add(&dev.sync_iev);
+	imsg_event_add2(&dev.sync_iev, ev_base_main);
 
 	/* Send a ready message over the sync channel. */
 	log_debug("%s: telling vm %s device is ready", __func__, vcp->vcp_name);
 	memset(&msg, 0, sizeof(msg));
 	msg.type = VIODEV_MSG_READY;
-	imsg_compose_event(&dev.sync_iev, IMSG_DEVOP_MSG, 0, 0, -1, &msg,
-	    sizeof(msg));
+	imsg_compose_event2(&dev.sync_iev, IMSG_DEVOP_MSG, 0, 0, -1, &msg,
+	    sizeof(msg), ev_base_main);
 
 	/* Send a ready message over the async channel. */
 	log_debug("%s: sending heartbeat", __func__);
-	ret = imsg_compose_event(&dev.async_iev, IMSG_DEVOP_MSG, 0, 0, -1,
-	    &msg, sizeof(msg));
+	ret = imsg_compose_event2(&dev.async_iev, IMSG_DEVOP_MSG, 0, 0, -1,
+	    &msg, sizeof(msg), ev_base_main);
 	if (ret == -1) {
 		log_warnx("%s: failed to send async ready message!", __func__);
 		goto fail;
 	}
 
 	/* Engage the event loop! */
-	ret = event_dispatch();
+	ret = event_base_dispatch(ev_base_main);
+	event_base_free(ev_base_main);
+
+	/* Try stopping the io thread cleanly by messaging it. */
+	vm_pipe_send(&pipe_io, VIRTIO_THREAD_STOP);
+
+	/* Wait for the io thread to stop. */
+	pthread_join(io_thread, NULL);
+	pthread_rwlock_destroy(&lock);
 
 	if (ret == 0) {
 		/* Clean shutdown. */
 		close_fd(dev.sync_fd);
 		close_fd(dev.async_fd);
+		close_fd(pipe_main.read);
+		close_fd(pipe_main.write);
+		close_fd(pipe_io.write);
 		for (i = 0; i < vioblk->ndisk_fd; i++)
 			close_fd(vioblk->disk_fd[i]);
 		_exit(0);
@@ -226,6 +277,8 @@ fail:
 		for (i = 0; i < vioblk->ndisk_fd; i++)
 			close_fd(vioblk->disk_fd[i]);
 	}
+	if (lock != NULL)
+		pthread_rwlock_destroy(&lock);
 	_exit(ret);
 	/* NOTREACHED */
 }
@@ -283,13 +336,14 @@ vioblk_update_qs(struct vioblk_dev *dev)
 }
 
 /*
- * Process virtqueue notifications. If an unrecoverable error occurs, puts
- * device into a "needs reset" state.
+ * Process virtqueue notifications.
  *
- * Returns 1 if an we need to assert an IRQ.
+ * Returns 1 if the driver should be notified. Otherwise, returns -1 on an
+ * unrecoverable error requiring a device reset or 0 if no notification is
+ * needed.
  */
 static int
-vioblk_notifyq(struct vioblk_dev *dev)
+vioblk_notifyq(struct virtio_dev *viodev)
 {
 	uint32_t cmd_len;
 	uint16_t idx, cmd_desc_idx;
@@ -298,11 +352,20 @@ vioblk_notifyq(struct vioblk_dev *dev)
 	ssize_t sz;
 	int is_write, notify = 0, i;
 	char *vr;
+	struct vioblk_dev *dev = &viodev->vioblk;
 	struct vring_desc *table, *desc;
 	struct vring_avail *avail;
 	struct vring_used *used;
 	struct virtio_blk_req_hdr *cmd;
 	struct virtio_vq_info *vq_info;
+	uint8_t status = 0;
+
+	status = dev->cfg.device_status
+	    & VIRTIO_CONFIG_DEVICE_STATUS_DRIVER_OK;
+	if (status != VIRTIO_CONFIG_DEVICE_STATUS_DRIVER_OK) {
+		log_warnx("%s: driver not ready", __func__);
+		return (0);
+	}
 
 	/* Invalid queue? */
 	if (dev->cfg.queue_notify > 0)
@@ -319,6 +382,12 @@ vioblk_notifyq(struct vioblk_dev *dev)
 	avail = (struct vring_avail *)(vr + vq_info->vq_availoffset);
 	used = (struct vring_used *)(vr + vq_info->vq_usedoffset);
 
+	/*
+	 * Suppress doorbells while we work the ring; the driver may skip
+	 * the notify register write for requests it posts meanwhile.
+	 */
+	used->flags |= VRING_USED_F_NO_NOTIFY;
+again:
 	while (idx != avail->idx) {
 		/* Retrieve Command descriptor. */
 		cmd_desc_idx = avail->ring[idx & VIOBLK_QUEUE_MASK];
@@ -399,7 +468,6 @@ vioblk_notifyq(struct vioblk_dev *dev)
 			log_warnx("%s: can't write device status data "
 			    "@ 0x%llx",__func__, desc->addr);
 
-		dev->cfg.isr_status |= 1;
 		notify = 1;
 
 		used->ring[used->idx & VIOBLK_QUEUE_MASK].id = cmd_desc_idx;
@@ -410,17 +478,25 @@ vioblk_notifyq(struct vioblk_dev *dev)
 		idx++;
 	}
 
+	used->flags &= ~VRING_USED_F_NO_NOTIFY;
+	__sync_synchronize();
+
+	/* Catch requests posted without a doorbell after our last check. */
+	if (idx != avail->idx) {
+		used->flags |= VRING_USED_F_NO_NOTIFY;
+		goto again;
+	}
+
+	/* The driver can ask us to skip the interrupt and poll instead. */
+	if (notify && (avail->flags & VRING_AVAIL_F_NO_INTERRUPT))
+		notify = 0;
+
 	vq_info->last_avail = idx;
 	return (notify);
 
 reset:
-	/*
-	 * When setting the "needs reset" flag, the driver is notified
-	 * via a configuration change interrupt.
-	 */
-	dev->cfg.device_status |= DEVICE_NEEDS_RESET;
-	dev->cfg.isr_status |= VIRTIO_CONFIG_ISR_CONFIG_CHANGE;
-	return (1);
+	used->flags &= ~VRING_USED_F_NO_NOTIFY;
+	return (-1);
 }
 
 static void
@@ -440,7 +516,7 @@ dev_dispatch_vm(int fd, short event, void *arg)
 			/* this pipe is dead, so remove the event handler */
 			log_debug("%s: pipe dead (EV_READ)", __func__);
 			event_del(&iev->ev);
-			event_loopexit(NULL);
+			event_base_loopexit(ev_base_main, NULL);
 			return;
 		}
 	}
@@ -452,7 +528,7 @@ dev_dispatch_vm(int fd, short event, void *arg)
 			/* this pipe is dead, so remove the event handler */
 			log_debug("%s: pipe dead (EV_WRITE)", __func__);
 			event_del(&iev->ev);
-			event_loopbreak();
+			event_base_loopbreak(ev_base_main);
 			return;
 		}
 	}
@@ -482,7 +558,7 @@ dev_dispatch_vm(int fd, short event, void *arg)
 		}
 		imsg_free(&imsg);
 	}
-	imsg_event_add(iev);
+	imsg_event_add2(iev, ev_base_main);
 }
 
 /*
@@ -507,7 +583,7 @@ handle_sync_io(int fd, short event, void *arg)
 			/* this pipe is dead, so remove the event handler */
 			log_debug("%s: vioblk pipe dead (EV_READ)", __func__);
 			event_del(&iev->ev);
-			event_loopexit(NULL);
+			event_base_loopexit(ev_base_main, NULL);
 			return;
 		}
 	}
@@ -519,7 +595,7 @@ handle_sync_io(int fd, short event, void *arg)
 			/* this pipe is dead, so remove the event handler */
 			log_debug("%s: vioblk pipe dead (EV_WRITE)", __func__);
 			event_del(&iev->ev);
-			event_loopexit(NULL);
+			event_base_loopexit(ev_base_main, NULL);
 			return;
 		}
 	}
@@ -549,31 +625,32 @@ handle_sync_io(int fd, short event, void *arg)
 			msg.data = handle_io_read(&msg, dev, &intr);
 			msg.data_valid = 1;
 			msg.state = intr;
-			imsg_compose_event(iev, IMSG_DEVOP_MSG, 0, 0, -1, &msg,
-			    sizeof(msg));
+			imsg_compose_event2(iev, IMSG_DEVOP_MSG, 0, 0, -1, &msg,
+			    sizeof(msg), ev_base_main);
 			break;
 		case VIODEV_MSG_IO_WRITE:
 			/* Write IO: no reply needed */
-			if (handle_io_write(&msg, dev) == 1)
-				virtio_assert_pic_irq(dev, 0);
+			handle_io_write(&msg, dev);
 			break;
 		case VIODEV_MSG_SHUTDOWN:
 			event_del(&dev->sync_iev.ev);
-			event_loopbreak();
+			event_base_loopbreak(ev_base_main);
 			return;
 		default:
 			fatalx("%s: invalid msg type %d", __func__, msg.type);
 		}
 	}
-	imsg_event_add(iev);
+	imsg_event_add2(iev, ev_base_main);
 }
 
-static int
+static void
 handle_io_write(struct viodev_msg *msg, struct virtio_dev *dev)
 {
 	struct vioblk_dev *vioblk = &dev->vioblk;
 	uint32_t data = msg->data;
-	int intr = 0;
+	int deassert = 0;
+
+	pthread_rwlock_wrlock(&lock);
 
 	switch (msg->reg) {
 	case VIRTIO_CONFIG_DEVICE_FEATURES:
@@ -597,8 +674,7 @@ handle_io_write(struct viodev_msg *msg, struct virtio_dev *dev)
 		/* XXX We should be stricter about status checks. */
 		if (!(vioblk->cfg.device_status & DEVICE_NEEDS_RESET)) {
 			vioblk->cfg.queue_notify = data;
-			if (vioblk_notifyq(vioblk))
-				intr = 1;
+			vm_pipe_send(&pipe_io, VIRTIO_NOTIFY);
 		}
 		break;
 	case VIRTIO_CONFIG_DEVICE_STATUS:
@@ -614,13 +690,16 @@ handle_io_write(struct viodev_msg *msg, struct virtio_dev *dev)
 			vioblk->cfg.isr_status = 0;
 			vioblk->vq[0].last_avail = 0;
 			vioblk->vq[0].notified_avail = 0;
-			virtio_deassert_pic_irq(dev, msg->vcpu);
+			deassert = 1;
 		}
 		break;
 	default:
 		break;
 	}
-	return (intr);
+
+	pthread_rwlock_unlock(&lock);
+	if (deassert)
+		vioblk_deassert_pic_irq(dev);
 }
 
 static uint32_t
@@ -635,6 +714,8 @@ handle_io_read(struct viodev_msg *msg, struct virtio_dev *dev, int8_t *intr)
 	else
 		data = 0;
 
+	pthread_rwlock_rdlock(&lock);
+
 	switch (msg->reg) {
 	case VIRTIO_CONFIG_DEVICE_CONFIG_NOMSI:
 		switch (sz) {
@@ -779,15 +860,18 @@ handle_io_read(struct viodev_msg *msg, struct virtio_dev *dev, int8_t *intr)
 		data = vioblk->cfg.device_status;
 		break;
 	case VIRTIO_CONFIG_ISR_STATUS:
+		pthread_rwlock_unlock(&lock);
+		pthread_rwlock_wrlock(&lock);
 		data = vioblk->cfg.isr_status;
 		vioblk->cfg.isr_status = 0;
 		if (intr != NULL)
 			*intr = INTR_STATE_DEASSERT;
 		break;
 	default:
-		return (0xFFFFFFFF);
+		data = 0xFFFFFFFF;
 	}
 
+	pthread_rwlock_unlock(&lock);
 	return (data);
 }
 
@@ -871,3 +955,147 @@ vioblk_rw(struct vioblk_dev *dev, int is_write, off_t offset,
 
 	return (sz);
 }
+
+/*
+ * Handle the disk io processing, communicating to the main thread via pipe.
+ */
+static void *
+io_run_loop(void *arg)
+{
+	int	 ret;
+
+	ev_base_io = event_base_new();
+
+	/* Wire up event handling for our inter-thread communication channel. */
+	event_base_set(ev_base_io, &pipe_io.read_ev);
+	event_add(&pipe_io.read_ev, NULL);
+
+	/* Begin our event loop with our channel event active. */
+	ret = event_base_dispatch(ev_base_io);
+	event_base_free(ev_base_io);
+
+	log_debug("%s: exiting (%d)", __func__, ret);
+
+	close_fd(pipe_io.read);
+
+	return (NULL);
+}
+
+/*
+ * Read events sent by the main thread to the io thread.
+ */
+static void
+read_pipe_io(int fd, short event, void *arg)
+{
+	struct virtio_dev	*dev = (struct virtio_dev *)arg;
+	struct vioblk_dev	*vioblk = &dev->vioblk;
+	enum pipe_msg_type	 msg;
+	int			 ret = 0;
+
+	if (!(event & EV_READ))
+		fatalx("%s: invalid event type", __func__);
+
+	msg = vm_pipe_recv(&pipe_io);
+
+	switch (msg) {
+	case VIRTIO_NOTIFY:
+		pthread_rwlock_rdlock(&lock);
+		ret = vioblk_notifyq(dev);
+		pthread_rwlock_unlock(&lock);
+		break;
+	case VIRTIO_THREAD_STOP:
+		event_base_loopexit(ev_base_io, NULL);
+		break;
+	default:
+		fatalx("%s: invalid channel message: %d", __func__, msg);
+	}
+
+	if (ret == 0) {
+		/* No notification needed. Return early. */
+		return;
+	}
+
+	pthread_rwlock_wrlock(&lock);
+	if (ret == 1) {
+		/* Notify the driver. */
+		vioblk->cfg.isr_status |= 1;
+	} else {
+		/*
+		 * Something went wrong. Set the "needs reset" flag and let
+		 * the driver know via a configuration change interrupt.
+		 */
+		log_warnx("%s: requesting device reset", __func__);
+		vioblk->cfg.device_status |= DEVICE_NEEDS_RESET;
+		vioblk->cfg.isr_status |= VIRTIO_CONFIG_ISR_CONFIG_CHANGE;
+	}
+	pthread_rwlock_unlock(&lock);
+
+	vm_pipe_send(&pipe_main, VIRTIO_RAISE_IRQ);
+}
+
+/*
+ * Read events sent by the io thread to the main thread.
+ */
+static void
+read_pipe_main(int fd, short event, void *arg)
+{
+	struct virtio_dev	*dev = (struct virtio_dev *)arg;
+	enum pipe_msg_type	 msg;
+
+	if (!(event & EV_READ))
+		fatalx("%s: invalid event type", __func__);
+
+	msg = vm_pipe_recv(&pipe_main);
+
+	switch (msg) {
+	case VIRTIO_RAISE_IRQ:
+		vioblk_assert_pic_irq(dev);
+		break;
+	default:
+		fatalx("%s: invalid channel msg: %d", __func__, msg);
+	}
+}
+
+/*
+ * Message the vm process asking to raise the irq. Must be called from the main
+ * thread.
+ */
+static void
+vioblk_assert_pic_irq(struct virtio_dev *dev)
+{
+	struct viodev_msg	msg;
+	int			ret;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.irq = dev->irq;
+	msg.vcpu = 0; // XXX
+	msg.type = VIODEV_MSG_KICK;
+	msg.state = INTR_STATE_ASSERT;
+
+	ret = imsg_compose_event2(&dev->async_iev, IMSG_DEVOP_MSG, 0, 0, -1,
+	    &msg, sizeof(msg), ev_base_main);
+	if (ret == -1)
+		log_warnx("%s: failed to assert irq %d", __func__, dev->irq);
+}
+
+/*
+ * Message the vm process asking to lower the irq. Must be called from the main
+ * thread.
+ */
+static void
+vioblk_deassert_pic_irq(struct virtio_dev *dev)
+{
+	struct viodev_msg	msg;
+	int			ret;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.irq = dev->irq;
+	msg.vcpu = 0; // XXX
+	msg.type = VIODEV_MSG_KICK;
+	msg.state = INTR_STATE_DEASSERT;
+
+	ret = imsg_compose_event2(&dev->async_iev, IMSG_DEVOP_MSG, 0, 0, -1,
+	    &msg, sizeof(msg), ev_base_main);
+	if (ret == -1)
+		log_warnx("%s: failed to deassert irq %d", __func__, dev->irq);
+}
@@ -2109,6 +2109,12 @@ vioscsi_notifyq(struct vioscsi_dev *dev)
 		return (0);
 	}
 
+	/*
+	 * Suppress doorbells while we work the ring; the driver may skip
+	 * the notify register write for requests it posts meanwhile.
+	 */
+	acct.used->flags |= VRING_USED_F_NO_NOTIFY;
+again:
 	cnt = 0;
 	while (acct.idx != (acct.avail->idx & VIOSCSI_QUEUE_MASK)) {
 
@@ -2251,6 +2257,22 @@ next_msg:
 		/* Increment to the next queue slot */
 		acct.idx = (acct.idx + 1) & VIOSCSI_QUEUE_MASK;
 	}
+
+	acct.used->flags &= ~VRING_USED_F_NO_NOTIFY;
+	__sync_synchronize();
+
+	/* Catch requests posted without a doorbell after our last check. */
+	if (acct.idx != (acct.avail->idx & VIOSCSI_QUEUE_MASK)) {
+		acct.used->flags |= VRING_USED_F_NO_NOTIFY;
+		goto again;
+	}
+
+	/* The driver can ask us to skip the interrupt and poll instead. */
+	if (ret && (acct.avail->flags & VRING_AVAIL_F_NO_INTERRUPT))
+		ret = 0;
+
+	return (ret);
 out:
+	acct.used->flags &= ~VRING_USED_F_NO_NOTIFY;
 	return (ret);
 }
@@ -52,10 +52,18 @@
 #include "ypdb.h"
 
 int  Verbose = 0;
+int  Parallel = 1;
 char Domain[HOST_NAME_MAX+1], Map[255];
 u_int32_t OrderNum;
 char *master;
 
+struct pushjob {
+	pid_t	pid;
+	u_int	prog;
+};
+static struct pushjob *jobs;
+static int running = 0;
+
 extern void yppush_xfrrespprog_1(struct svc_req *request, SVCXPRT *xprt);
 extern bool_t xdr_ypreq_xfr(XDR *, struct ypreq_xfr *);
 
@@ -63,10 +71,31 @@ static void
 usage(void)
 {
 	fprintf(stderr,
-	    "usage: yppush [-v] [-d domainname] [-h hostname] mapname\n");
+	    "usage: yppush [-v] [-d domainname] [-h hostname] "
+	    "[-p paralleljobs] mapname\n");
 	exit(1);
 }
 
+static void
+reap_job(void)
+{
+	struct rusage res;
+	int status, i;
+	pid_t pid;
+
+	pid = wait4(WAIT_ANY, &status, 0, &res);
+	if (pid <= 0)
+		return;
+	for (i = 0; i < running; i++) {
+		if (jobs[i].pid == pid) {
+			/* the callback listener is gone, drop its program */
+			svc_unregister(jobs[i].prog, 1);
+			jobs[i] = jobs[--running];
+			break;
+		}
+	}
+}
+
 static void
 my_svc_run(void)
 {
@@ -144,14 +173,17 @@ push(int inlen, char *indata)
 	char host[HOST_NAME_MAX+1];
 	CLIENT *client;
 	SVCXPRT *transp;
-	int sock = RPC_ANYSOCK, status;
+	int sock = RPC_ANYSOCK;
 	u_int prog;
 	bool_t sts = 0;
 	pid_t pid;
-	struct rusage res;
 
 	snprintf(host, sizeof host, "%*.*s", inlen, inlen, indata);
 
+	/* each transfer runs until its slave calls back; bound the fan-out */
+	while (running >= Parallel)
+		reap_job();
+
 	client = clnt_create(host, YPPROG, YPVERS, "tcp");
 	if (client == NULL) {
 		if (Verbose)
@@ -193,10 +225,12 @@ push(int inlen, char *indata)
 		close(transp->xp_sock);
 		transp->xp_sock = -1;
 		req_xfr(pid, prog, transp, host, client);
-		wait4(pid, &status, 0, &res);
-		svc_unregister(prog, 1);
 		if (client != NULL)
 			clnt_destroy(client);
+		/* the child owns the callback program until it exits */
+		jobs[running].pid = pid;
+		jobs[running].prog = prog;
+		running++;
 		/* XXX transp leak? */
 	}
 
@@ -219,6 +253,7 @@ main(int argc, char *argv[])
 	extern char *optarg;
 	extern int optind;
 	char	*domain, *map, *hostname;
+	const char *errstr;
 	int c, r, i;
 	char *ypmap = "ypservers";
 	CLIENT *client;
@@ -230,7 +265,7 @@ main(int argc, char *argv[])
 
 	yp_get_default_domain(&domain);
 	hostname = NULL;
-	while ((c=getopt(argc, argv, "d:h:v")) != -1)
+	while ((c=getopt(argc, argv, "d:h:p:v")) != -1)
 		switch (c) {
 		case 'd':
 			domain = optarg;
@@ -238,6 +273,15 @@ main(int argc, char *argv[])
 		case 'h':
 			hostname = optarg;
 			break;
+		case 'p':
+			Parallel = strtonum(optarg, 1, 64, &errstr);
+			if (errstr != NULL) {
+				fprintf(stderr,
+				    "yppush: parallel jobs is %s: %s\n",
+				    errstr, optarg);
+				usage();
+			}
+			break;
 		case 'v':
 			Verbose = 1;
 			break;
@@ -251,6 +295,12 @@ main(int argc, char *argv[])
 
 	map = argv[optind];
 
+	jobs = reallocarray(NULL, Parallel, sizeof(*jobs));
+	if (jobs == NULL) {
+		fprintf(stderr, "yppush: Cannot allocate job table.\n");
+		exit(1);
+	}
+
 	strncpy(Domain, domain, sizeof(Domain)-1);
 	Domain[sizeof(Domain)-1] = '\0';
 	strncpy(Map, map, sizeof(Map)-1);
@@ -325,5 +375,9 @@ main(int argc, char *argv[])
 		r = yp_all_host(client, Domain, ypmap, &ypcb);
 	}
 
+	/* wait for the transfers still in flight */
+	while (running > 0)
+		reap_job();
+
 	exit(0);
 }